@@ -1,9 +1,13 @@
 #pragma once
 
 // Include all local search files
+#include "algorithms/local_search/cross_exchange_search.h"
 #include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/or_opt_search.h"
+#include "algorithms/local_search/swts_reassignment_search.h"
 #include "algorithms/local_search/task_exchange_between_routes_search.h"
 #include "algorithms/local_search/task_exchange_within_route_search.h"
 #include "algorithms/local_search/task_reinsertion_between_routes_search.h"
 #include "algorithms/local_search/task_reinsertion_within_route_search.h"
 #include "algorithms/local_search/two_opt_search.h"
+#include "algorithms/local_search/two_opt_star_search.h"
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "algorithms/vrpt_solution.h"
+#include "problem/location.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class GiantTour
+ * @brief Compact CV solution encoding: one sequence of all collection zones
+ *
+ * The tour lists the zones in the order the fleet serves them, without depot, SWTS or route
+ * boundaries. It is a flat array of location indices, so copying it to another thread or keeping
+ * a population of them costs a few hundred bytes each instead of a full VRPTSolution.
+ *
+ * decode() turns the tour back into CV routes with a Split in the style of Prins, keeping the
+ * zone order and following the T1/T2 leg structure of GRASPCVGenerator. Inside a route, a leg
+ * ends at the SWTS nearest to its last zone as soon as the next zone no longer fits in the
+ * vehicle, and the route returns to the depot after its last leg. Where routes start and end is
+ * chosen optimally, fewest routes first and then shortest total duration. Every candidate route
+ * extends the previous one by a zone, so it is priced and checked with O(1) RouteSegment
+ * concatenations, and the scan from each start stops at the first route exceeding the maximum
+ * duration. Decoding costs O(n * b), where b is the most zones a route can serve.
+ *
+ * Zones no route can serve on their own are left unvisited.
+ */
+class GiantTour {
+ public:
+  GiantTour() = default;
+
+  explicit GiantTour(std::vector<LocationIndex> zones) : zones_(std::move(zones)) {}
+
+  /**
+   * @brief Encode a solution by concatenating the zones of its CV routes
+   *
+   * Zones the solution does not visit are appended in problem order, so the tour always covers
+   * every zone.
+   */
+  [[nodiscard]] static GiantTour
+    fromSolution(const VRPTSolution& solution, const VRPTProblem& problem);
+
+  /**
+   * @brief Decode the tour into a solution with CV routes only
+   */
+  [[nodiscard]] VRPTSolution decode(const VRPTProblem& problem) const;
+
+  [[nodiscard]] std::span<const LocationIndex> zones() const noexcept { return zones_; }
+
+  // Mutable view for permutation operators; the set of zones must stay the same
+  [[nodiscard]] std::span<LocationIndex> zones() noexcept { return zones_; }
+
+  [[nodiscard]] std::size_t size() const noexcept { return zones_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return zones_.empty(); }
+
+  [[nodiscard]] bool operator==(const GiantTour&) const = default;
+
+ private:
+  std::vector<LocationIndex> zones_;
+};
+
+}  // namespace algorithm
+}  // namespace daa
@@ -45,10 +45,9 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
     std::mt19937 gen(rd());
 
     // Get all collection zones
-    std::vector<Location> zones = problem.getZones();
-    std::unordered_set<std::string> unassigned_zones;
-    for (const auto& zone : zones) {
-      unassigned_zones.insert(zone.id());
+    std::unordered_set<LocationIndex> unassigned_zones;
+    for (const auto zone : problem.getZones()) {
+      unassigned_zones.insert(zone);
     }
 
     // Vehicle parameters
@@ -71,8 +70,7 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
       // Add T2 legs (SWTS -> Zones -> SWTS) while possible
       while (!unassigned_zones.empty()) {
         // Calculate return time to depot from current location
-        Duration return_time =
-          problem.getTravelTime(route.lastLocationId(), problem.getDepot().id());
+        Duration return_time = problem.getTravelTime(route.lastLocation(), problem.getDepotIndex());
 
         // Make sure we have enough time for another leg plus return to depot
         if (route.totalDuration() + return_time >= route.residualTime()) {
@@ -134,26 +132,26 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
    */
   bool buildT1Leg(
     CVRoute& route,
-    std::unordered_set<std::string>& unassigned_zones,
+    std::unordered_set<LocationIndex>& unassigned_zones,
     const VRPTProblem& problem,
     std::mt19937& gen
   ) {
 
     // Start location is depot
-    std::string current_location_id = problem.getDepot().id();
+    LocationIndex current_location = problem.getDepotIndex();
     bool added_zones = false;
 
     // Keep adding zones until capacity is reached or no more can be added
     while (!unassigned_zones.empty()) {
       // Build candidate list of feasible zones
-      std::vector<std::pair<std::string, double>> candidates;
+      std::vector<std::pair<LocationIndex, double>> candidates;
 
-      for (const auto& zone_id : unassigned_zones) {
+      for (const auto zone_index : unassigned_zones) {
         // Check if this zone can be added to the route
-        if (route.canVisit(zone_id, problem)) {
+        if (route.canVisit(zone_index, problem)) {
           // Calculate distance from current location
-          double distance = problem.getDistance(current_location_id, zone_id).value();
-          candidates.emplace_back(zone_id, distance);
+          double distance = problem.getDistance(current_location, zone_index).value();
+          candidates.emplace_back(zone_index, distance);
         }
       }
 
@@ -163,11 +161,11 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
       }
 
       // Apply GRASP selection from candidates
-      std::string selected_zone = selectCandidateFromRCL(candidates, gen);
+      LocationIndex selected_zone = selectCandidateFromRCL(candidates, gen);
 
       // Add the selected zone to the route
       route.addLocation(selected_zone, problem);
-      current_location_id = selected_zone;
+      current_location = selected_zone;
       unassigned_zones.erase(selected_zone);
       added_zones = true;
     }
@@ -175,19 +173,18 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
     // If we added zones, finish the leg by going to the nearest SWTS
     if (added_zones) {
       // Get SWTS candidates
-      auto swts_locations = problem.getSWTS();
-      std::vector<std::pair<std::string, double>> swts_candidates;
+      std::vector<std::pair<LocationIndex, double>> swts_candidates;
 
-      for (const auto& swts : swts_locations) {
-        if (route.canVisit(swts.id(), problem)) {
-          double distance = problem.getDistance(current_location_id, swts.id()).value();
-          swts_candidates.emplace_back(swts.id(), distance);
+      for (const auto swts : problem.getSWTS()) {
+        if (route.canVisit(swts, problem)) {
+          double distance = problem.getDistance(current_location, swts).value();
+          swts_candidates.emplace_back(swts, distance);
         }
       }
 
       if (!swts_candidates.empty()) {
         // Select SWTS using GRASP
-        std::string selected_swts = selectCandidateFromRCL(swts_candidates, gen);
+        LocationIndex selected_swts = selectCandidateFromRCL(swts_candidates, gen);
 
         // Add SWTS to complete T1 leg
         route.addLocation(selected_swts, problem);
@@ -209,26 +206,26 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
    */
   bool buildT2Leg(
     CVRoute& route,
-    std::unordered_set<std::string>& unassigned_zones,
+    std::unordered_set<LocationIndex>& unassigned_zones,
     const VRPTProblem& problem,
     std::mt19937& gen
   ) {
 
     // Current location should be a SWTS
-    std::string current_location_id = route.lastLocationId();
+    LocationIndex current_location = route.lastLocation();
     bool added_zones = false;
 
     // Keep adding zones until capacity is reached or no more can be added
     while (!unassigned_zones.empty()) {
       // Build candidate list of feasible zones
-      std::vector<std::pair<std::string, double>> candidates;
+      std::vector<std::pair<LocationIndex, double>> candidates;
 
-      for (const auto& zone_id : unassigned_zones) {
+      for (const auto zone_index : unassigned_zones) {
         // Check if this zone can be added to the route
-        if (route.canVisit(zone_id, problem)) {
+        if (route.canVisit(zone_index, problem)) {
           // Calculate distance from current location
-          double distance = problem.getDistance(current_location_id, zone_id).value();
-          candidates.emplace_back(zone_id, distance);
+          double distance = problem.getDistance(current_location, zone_index).value();
+          candidates.emplace_back(zone_index, distance);
         }
       }
 
@@ -238,11 +235,11 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
       }
 
       // Apply GRASP selection from candidates
-      std::string selected_zone = selectCandidateFromRCL(candidates, gen);
+      LocationIndex selected_zone = selectCandidateFromRCL(candidates, gen);
 
       // Add the selected zone to the route
       route.addLocation(selected_zone, problem);
-      current_location_id = selected_zone;
+      current_location = selected_zone;
       unassigned_zones.erase(selected_zone);
       added_zones = true;
     }
@@ -250,19 +247,18 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
     // If we added zones, finish the leg by going to the nearest SWTS
     if (added_zones) {
       // Get SWTS candidates
-      auto swts_locations = problem.getSWTS();
-      std::vector<std::pair<std::string, double>> swts_candidates;
+      std::vector<std::pair<LocationIndex, double>> swts_candidates;
 
-      for (const auto& swts : swts_locations) {
-        if (route.canVisit(swts.id(), problem)) {
-          double distance = problem.getDistance(current_location_id, swts.id()).value();
-          swts_candidates.emplace_back(swts.id(), distance);
+      for (const auto swts : problem.getSWTS()) {
+        if (route.canVisit(swts, problem)) {
+          double distance = problem.getDistance(current_location, swts).value();
+          swts_candidates.emplace_back(swts, distance);
         }
       }
 
       if (!swts_candidates.empty()) {
         // Select SWTS using GRASP
-        std::string selected_swts = selectCandidateFromRCL(swts_candidates, gen);
+        LocationIndex selected_swts = selectCandidateFromRCL(swts_candidates, gen);
 
         // Add SWTS to complete T2 leg
         route.addLocation(selected_swts, problem);
@@ -278,15 +274,15 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
    * @brief Select a candidate from a restricted candidate list using GRASP
    * @param candidates Vector of candidates with their distances
    * @param gen Random number generator
-   * @return Selected candidate ID
+   * @return Selected candidate index
    */
-  std::string selectCandidateFromRCL(
-    const std::vector<std::pair<std::string, double>>& candidates,
+  LocationIndex selectCandidateFromRCL(
+    const std::vector<std::pair<LocationIndex, double>>& candidates,
     std::mt19937& gen
   ) {
 
     if (candidates.empty()) {
-      return "";
+      return invalid_location_index;
     }
 
     if (candidates.size() == 1 || alpha_ <= 0.0) {
@@ -300,15 +296,15 @@ class GRASPCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTProb
     });
 
     // Build restricted candidate list (RCL)
-    std::vector<std::string> rcl;
+    std::vector<LocationIndex> rcl;
     double min_dist = sorted_candidates.front().second;
     double max_dist = sorted_candidates.back().second;
     double threshold = min_dist + alpha_ * (max_dist - min_dist);
 
     // Add candidates that meet the threshold
-    for (const auto& [id, distance] : sorted_candidates) {
+    for (const auto& [index, distance] : sorted_candidates) {
       if (distance <= threshold) {
-        rcl.push_back(id);
+        rcl.push_back(index);
         if (rcl.size() >= rcl_size_) {
           break;
         }
@@ -30,11 +30,12 @@ class GreedyCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTPro
   VRPTSolution generateSolution(const VRPTProblem& problem) override {
     VRPTSolution solution;
 
+    const auto& table = problem.getLocationTable();
+
     // Get all collection zones (line 3: while C ≠ ∅)
-    std::vector<Location> zones = problem.getZones();
-    std::unordered_set<std::string> unassigned_zones;
-    for (const auto& zone : zones) {
-      unassigned_zones.insert(zone.id());
+    std::unordered_set<LocationIndex> unassigned_zones;
+    for (const auto zone : problem.getZones()) {
+      unassigned_zones.insert(zone);
     }
 
     // Generate routes until all zones are assigned
@@ -45,39 +46,37 @@ class GreedyCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTPro
       CVRoute route(vehicle_id, problem.getCVCapacity(), problem.getCVMaxDuration());
 
       // Start from depot (implicit in line 4: Rk ← {depot})
-      std::string current_location_id = problem.getDepot().id();
+      LocationIndex current_location = problem.getDepotIndex();
 
       // Main route building loop (line 7: while true)
       while (true) {
         // Find closest unassigned zone (line 8)
-        std::optional<std::string> closest_zone;
+        std::optional<LocationIndex> closest_zone;
         double min_distance = std::numeric_limits<double>::max();
 
-        for (const auto& zone_id : unassigned_zones) {
-          double distance = problem.getDistance(current_location_id, zone_id).value();
+        for (const auto zone_index : unassigned_zones) {
+          double distance = problem.getDistance(current_location, zone_index).value();
           if (distance < min_distance) {
             // Check feasibility (lines 9-10)
             // Time needed to visit zone, a SWTS, and return to depot
-            const auto& zone = problem.getLocation(zone_id);
-            auto nearest_swts = problem.findNearest(zone, LocationType::SWTS);
+            const auto& depot_return = problem.getDepotReturn(zone_index);
 
-            if (!nearest_swts)
+            if (depot_return.nearest_swts == invalid_location_index)
               continue;
 
-            Duration travel_time_to_zone = problem.getTravelTime(current_location_id, zone_id);
-            Duration service_time = zone.serviceTime();
-            Duration travel_time_to_swts = problem.getTravelTime(zone_id, nearest_swts->id());
-            Duration travel_time_to_depot =
-              problem.getTravelTime(nearest_swts->id(), problem.getDepot().id());
+            Duration travel_time_to_zone = problem.getTravelTime(current_location, zone_index);
+            Duration service_time = table.serviceTime(zone_index);
+            Duration travel_time_to_swts = depot_return.to_swts;
+            Duration travel_time_to_depot = depot_return.swts_to_depot;
 
             Duration total_time =
               travel_time_to_zone + service_time + travel_time_to_swts + travel_time_to_depot;
 
             // Check capacity and time constraints
-            if (zone.wasteAmount() <= route.residualCapacity() &&
+            if (table.wasteAmount(zone_index) <= route.residualCapacity() &&
                 total_time <= route.residualTime()) {
               min_distance = distance;
-              closest_zone = zone_id;
+              closest_zone = zone_index;
             }
           }
         }
@@ -85,29 +84,27 @@ class GreedyCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTPro
         if (closest_zone) {
           // Add zone to route (lines 11-14)
           route.addLocation(*closest_zone, problem);
-          current_location_id = *closest_zone;
+          current_location = *closest_zone;
           unassigned_zones.erase(*closest_zone);
         } else {
           // Cannot add a zone directly (lines 15-16)
           // Check if going to SWTS is feasible time-wise
-          const auto& current_loc = problem.getLocation(current_location_id);
-
           // If we're already at an SWTS and can't find any feasible zones,
           // there's no point in visiting another SWTS - break the loop
-          if (current_loc.type() == LocationType::SWTS) {
+          if (table.type(current_location) == LocationType::SWTS) {
             break;
           }
 
-          auto nearest_swts = problem.findNearest(current_loc, LocationType::SWTS);
+          const LocationIndex nearest_swts = problem.getNearestSWTS(current_location);
 
-          if (!nearest_swts) {
+          if (nearest_swts == invalid_location_index) {
             break;  // No SWTS found, can't continue
           }
 
-          if (nearest_swts && route.canVisit(nearest_swts->id(), problem)) {
+          if (route.canVisit(nearest_swts, problem)) {
             // Go to SWTS and reset capacity (lines 17-20)
-            route.addLocation(nearest_swts->id(), problem);
-            current_location_id = nearest_swts->id();
+            route.addLocation(nearest_swts, problem);
+            current_location = nearest_swts;
             // After visiting SWTS, we'll try to find feasible zones in the next iteration
           } else {
             // Cannot continue this route (line 22)
@@ -117,17 +114,16 @@ class GreedyCVGenerator : public ::meta::SolutionGenerator<VRPTSolution, VRPTPro
       }
 
       // Finalize the route (lines 26-31)
-      const auto& current_loc = problem.getLocation(current_location_id);
-      if (current_loc.type() != LocationType::SWTS) {
+      if (table.type(current_location) != LocationType::SWTS) {
         // If not at SWTS, find closest SWTS and go there
-        auto nearest_swts = problem.findNearest(current_loc, LocationType::SWTS);
-        if (nearest_swts && route.canVisit(nearest_swts->id(), problem)) {
-          route.addLocation(nearest_swts->id(), problem);
+        const LocationIndex nearest_swts = problem.getNearestSWTS(current_location);
+        if (nearest_swts != invalid_location_index && route.canVisit(nearest_swts, problem)) {
+          route.addLocation(nearest_swts, problem);
         }
       }
 
       // Return to depot
-      route.addLocation(problem.getDepot().id(), problem);
+      route.addLocation(problem.getDepotIndex(), problem);
 
       // Add route to solution if it's not empty (line 32)
       if (!route.isEmpty()) {
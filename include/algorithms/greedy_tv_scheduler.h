@@ -56,8 +56,8 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
     VRPTSolution solution = data.solution;
     const VRPTProblem& problem = data.problem;
 
-    // Get all delivery tasks from CV routes, sorted by arrival time
-    std::vector<DeliveryTask> tasks = solution.getAllDeliveryTasks();
+    // Delivery tasks from CV routes, merged in arrival order as they are consumed
+    DeliveryTaskStream tasks = solution.deliveryTasks();
 
     // Check if there are any tasks
     if (tasks.empty()) {
@@ -67,18 +67,22 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
 
     // Determine minimum waste amount (q_min) for deciding when to return to landfill
     Capacity q_min = tasks.front().amount();
-    for (const auto& task : tasks) {
-      if (task.amount() < q_min) {
-        q_min = task.amount();
+    for (const auto& cv_route : solution.getCVRoutes()) {
+      for (const auto& task : cv_route.deliveries()) {
+        if (task.amount() < q_min) {
+          q_min = task.amount();
+        }
       }
     }
 
     // Initialize empty set of TV routes
     std::vector<TVRoute> tv_routes;
 
-    // Process each task in order of arrival time (tasks are already sorted)
-    for (size_t i = 0; i < tasks.size(); ++i) {
-      const auto& task = tasks[i];
+    // Process each task in order of arrival time, looking ahead at the one after it
+    while (!tasks.empty()) {
+      const auto& task = tasks.front();
+      tasks.pop();
+      const DeliveryTask* next_task = tasks.empty() ? nullptr : &tasks.front();
 
       int best_vehicle_idx = -1;
       std::optional<Duration> min_insertion_cost = std::nullopt;
@@ -89,11 +93,11 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
         auto& route = tv_routes[e];
 
         // Check feasibility conditions
-        const std::string& last_location = route.lastLocationId();
+        const LocationIndex last_location = route.lastLocation();
 
-        Duration travel_time = (last_location.empty())
+        Duration travel_time = (last_location == invalid_location_index)
                                ? Duration{0.0}
-                               : problem.getTravelTime(last_location, task.swtsId());
+                               : problem.getTravelTime(last_location, task.swts());
 
         // (a) Timing: We can always handle the task regardless of when we arrive
         // If we arrive early, we'll wait; if we arrive late, the task is missed
@@ -115,12 +119,12 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
         bool can_visit_landfill_during_wait = false;
         Duration landfill_detour_time = Duration{0.0};
 
-        const std::string& landfill_id = problem.getLandfill().id();
+        const LocationIndex landfill = problem.getLandfillIndex();
 
         if (!capacity_feasible && waiting_time > Duration{0.0}) {
           // Calculate time needed for landfill detour
-          Duration to_landfill = problem.getTravelTime(last_location, landfill_id);
-          Duration from_landfill = problem.getTravelTime(landfill_id, task.swtsId());
+          Duration to_landfill = problem.getTravelTime(last_location, landfill);
+          Duration from_landfill = problem.getTravelTime(landfill, task.swts());
           landfill_detour_time = to_landfill + from_landfill;
 
           // Check if we can visit landfill during waiting time
@@ -134,7 +138,7 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
         }
 
         // (c) Duration: Can we visit SWTS and still return to landfill within time limit?
-        Duration return_time = problem.getTravelTime(task.swtsId(), landfill_id);
+        Duration return_time = problem.getTravelTime(task.swts(), landfill);
 
         // The effective task service time is the max of TV arrival time and task arrival time
         Duration effective_service_time;
@@ -147,8 +151,8 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
         } else if (!capacity_feasible) {
           // If capacity is not feasible and we can't use waiting time for landfill,
           // we need to go to landfill first and then to the task
-          Duration to_landfill = problem.getTravelTime(last_location, landfill_id);
-          Duration from_landfill = problem.getTravelTime(landfill_id, task.swtsId());
+          Duration to_landfill = problem.getTravelTime(last_location, landfill);
+          Duration from_landfill = problem.getTravelTime(landfill, task.swts());
 
           tv_arrival_time = route.currentTime() + to_landfill + from_landfill;
 
@@ -176,13 +180,12 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
 
           // Look ahead to see if this vehicle will be useful for future tasks
           bool good_for_future = false;
-          if (i < tasks.size() - 1) {
-            const auto& next_task = tasks[i + 1];
-            Duration time_to_next = next_task.arrivalTime() - effective_service_time;
-            Duration travel_to_next = problem.getTravelTime(task.swtsId(), next_task.swtsId());
+          if (next_task != nullptr) {
+            Duration time_to_next = next_task->arrivalTime() - effective_service_time;
+            Duration travel_to_next = problem.getTravelTime(task.swts(), next_task->swts());
 
             if (travel_to_next <= time_to_next &&
-                route.residualCapacity() - task.amount() >= next_task.amount()) {
+                route.residualCapacity() - task.amount() >= next_task->amount()) {
               good_for_future = true;
             }
           }
@@ -209,26 +212,25 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
         };
 
         // Start from landfill
-        new_route.addLocation(problem.getLandfill().id(), problem);
+        new_route.addLocation(problem.getLandfillIndex(), problem);
 
         // Add pickup at SWTS
         bool pickup_success =
-          new_route.addPickup(task.swtsId(), task.arrivalTime(), task.amount(), problem);
+          new_route.addPickup(task.swts(), task.arrivalTime(), task.amount(), problem);
 
         if (!pickup_success) {
           throw TVSchedulerError("Failed to add pickup to new route!");
         }
 
         // Only return to landfill if capacity is very low or if it's the last task
-        bool return_to_landfill = new_route.residualCapacity() < q_min || (i == tasks.size() - 1);
+        bool return_to_landfill = new_route.residualCapacity() < q_min || next_task == nullptr;
 
         // Also consider returning if next task is far in the future
-        if (i < tasks.size() - 1) {
-          const auto& next_task = tasks[i + 1];
-          Duration time_to_next = next_task.arrivalTime() - task.arrivalTime();
-          Duration to_landfill = problem.getTravelTime(task.swtsId(), problem.getLandfill().id());
+        if (next_task != nullptr) {
+          Duration time_to_next = next_task->arrivalTime() - task.arrivalTime();
+          Duration to_landfill = problem.getTravelTime(task.swts(), problem.getLandfillIndex());
           Duration from_landfill =
-            problem.getTravelTime(problem.getLandfill().id(), next_task.swtsId());
+            problem.getTravelTime(problem.getLandfillIndex(), next_task->swts());
 
           if (to_landfill + from_landfill <= time_to_next) {
             return_to_landfill = true;
@@ -236,39 +238,39 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
         }
 
         if (return_to_landfill) {
-          new_route.addLocation(problem.getLandfill().id(), problem);
+          new_route.addLocation(problem.getLandfillIndex(), problem);
         }
 
         tv_routes.push_back(std::move(new_route));
       } else {
         // Add to existing route
         auto& route = tv_routes[best_vehicle_idx];
-        const std::string& last_location = route.lastLocationId();
+        const LocationIndex last_location = route.lastLocation();
 
         // Check if we need to visit landfill first due to capacity
         if (need_landfill_return || route.residualCapacity() < task.amount()) {
-          route.addLocation(problem.getLandfill().id(), problem);
-        } else if (!last_location.empty() && last_location != task.swtsId()) {
+          route.addLocation(problem.getLandfillIndex(), problem);
+        } else if (last_location != invalid_location_index && last_location != task.swts()) {
           // Check if we have significant waiting time to visit landfill
-          Duration travel_time = problem.getTravelTime(last_location, task.swtsId());
+          Duration travel_time = problem.getTravelTime(last_location, task.swts());
           Duration tv_arrival_time = route.currentTime() + travel_time;
 
           if (tv_arrival_time < task.arrivalTime()) {
             Duration waiting_time = task.arrivalTime() - tv_arrival_time;
-            const std::string& landfill_id = problem.getLandfill().id();
+            const LocationIndex landfill = problem.getLandfillIndex();
 
-            Duration to_landfill = problem.getTravelTime(last_location, landfill_id);
-            Duration from_landfill = problem.getTravelTime(landfill_id, task.swtsId());
+            Duration to_landfill = problem.getTravelTime(last_location, landfill);
+            Duration from_landfill = problem.getTravelTime(landfill, task.swts());
 
             if (to_landfill + from_landfill <= waiting_time) {
               // Use waiting time to visit landfill
-              route.addLocation(landfill_id, problem);
+              route.addLocation(landfill, problem);
             }
           }
         }
 
         bool pickup_success =
-          route.addPickup(task.swtsId(), task.arrivalTime(), task.amount(), problem);
+          route.addPickup(task.swts(), task.arrivalTime(), task.amount(), problem);
 
         if (!pickup_success) {
           throw TVSchedulerError("Failed to add pickup to existing route!");
@@ -276,37 +278,36 @@ class GreedyTVScheduler : public TypedAlgorithm<VRPTData, VRPTSolution> {
 
         // Consider whether to return to landfill after this task
         // Look ahead to next task to decide
-        bool return_to_landfill = route.residualCapacity() < q_min || (i == tasks.size() - 1);
+        bool return_to_landfill = route.residualCapacity() < q_min || next_task == nullptr;
 
         // Consider returning if it's beneficial for the next task
-        if (i < tasks.size() - 1 && !return_to_landfill) {
-          const auto& next_task = tasks[i + 1];
-          Duration time_to_next = next_task.arrivalTime() - task.arrivalTime();
-          Duration to_landfill = problem.getTravelTime(task.swtsId(), problem.getLandfill().id());
+        if (next_task != nullptr && !return_to_landfill) {
+          Duration time_to_next = next_task->arrivalTime() - task.arrivalTime();
+          Duration to_landfill = problem.getTravelTime(task.swts(), problem.getLandfillIndex());
           Duration from_landfill =
-            problem.getTravelTime(problem.getLandfill().id(), next_task.swtsId());
-          Duration direct_to_next = problem.getTravelTime(task.swtsId(), next_task.swtsId());
+            problem.getTravelTime(problem.getLandfillIndex(), next_task->swts());
+          Duration direct_to_next = problem.getTravelTime(task.swts(), next_task->swts());
 
           // Return to landfill if:
           // 1. It fits within the time window, and
           // 2. Either we need more capacity for next task or it's more efficient
           if (to_landfill + from_landfill <= time_to_next &&
-              (route.residualCapacity() < next_task.amount() ||
+              (route.residualCapacity() < next_task->amount() ||
                to_landfill + from_landfill < direct_to_next)) {
             return_to_landfill = true;
           }
         }
 
         if (return_to_landfill) {
-          route.addLocation(problem.getLandfill().id(), problem);
+          route.addLocation(problem.getLandfillIndex(), problem);
         }
       }
     }
 
     // Finalization: Ensure all routes end at the landfill
     for (auto& route : tv_routes) {
-      if (!route.isEmpty() && route.lastLocationId() != problem.getLandfill().id()) {
-        route.addLocation(problem.getLandfill().id(), problem);
+      if (!route.isEmpty() && route.lastLocation() != problem.getLandfillIndex()) {
+        route.addLocation(problem.getLandfillIndex(), problem);
       }
     }
 
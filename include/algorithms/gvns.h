@@ -2,7 +2,6 @@
 
 #include <latch>
 #include <memory>
-#include <mutex>
 #include <random>
 #include <string>
 #include <thread>
@@ -12,6 +11,8 @@
 #include "algorithms/neighborhood_bitmap.h"
 
 #include "algorithm_registry.h"
+#include "algorithms/incumbent_store.h"
+#include "algorithms/local_search/cv_local_search.h"
 #include "algorithms/vrpt_solution.h"
 #include "meta_heuristic_components.h"
 #include "meta_heuristic_factory.h"
@@ -69,12 +70,9 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
     // Generate initial solution
     VRPTSolution initial_solution = generator_->generateSolution(problem);
 
-    // Thread-safe container for the best solution
-    std::mutex best_solution_mutex;
-    VRPTSolution best_solution = initial_solution;
-    size_t best_cv_count = best_solution.getCVCount();
-    size_t best_zones_count = best_solution.visitedZones(problem);
-    Duration best_total_duration = best_solution.totalDuration();
+    // Workers publish improvements without serializing on a lock
+    incumbent_.clear();
+    incumbent_.offer(initial_solution);
 
     // Create a thread pool
     const unsigned int thread_count = std::thread::hardware_concurrency();
@@ -108,78 +106,54 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
         // Start with a copy of the initial solution
         VRPTSolution current_solution = initial_solution;
 
+        // Kept across iterations: every solution of this thread descends from the previous one,
+        // so the exhaustion stamps of the neighborhoods stay meaningful after shaking
+        NeighborhoodBitmap available_neighborhoods(thread_neighborhoods.size());
+
         // Process assigned iterations
         for (unsigned int iteration = start_idx; iteration < end_idx; ++iteration) {
           // Random Variable Neighborhood Descent (RVND)
-          NeighborhoodBitmap available_neighborhoods(thread_neighborhoods.size());
+          available_neighborhoods.resetAll();
 
           while (available_neighborhoods.hasAvailable()) {
             // Randomly select neighborhood
             size_t k = available_neighborhoods.selectRandom(gen);
 
-            // Apply current neighborhood search
-            VRPTSolution improved_solution =
-              thread_neighborhoods[k]->improveSolution(problem, current_solution);
-
-            // Check if solution improved using all criteria
-            size_t improved_cv_count = improved_solution.getCVCount();
-            size_t improved_zones_count = improved_solution.visitedZones(problem);
-            Duration improved_total_duration = improved_solution.totalDuration();
+            // Nothing changed since this neighborhood last came up empty
+            if (available_neighborhoods.isExhausted(k, current_solution.lastStamp())) {
+              available_neighborhoods.markUnavailable(k);
+              continue;
+            }
 
-            bool is_better = false;
+            // Apply current neighborhood search, only over the routes changed since it was
+            // last exhausted when it is a CV route search
+            auto* cv_search = dynamic_cast<CVLocalSearch*>(thread_neighborhoods[k].get());
+            VRPTSolution improved_solution =
+              cv_search != nullptr
+                ? cv_search->improveChangedRoutes(
+                    problem, current_solution, available_neighborhoods.exhaustedAt(k)
+                  )
+                : thread_neighborhoods[k]->improveSolution(problem, current_solution);
 
             // Solution is better if:
             // 1. It uses fewer vehicles, OR
             // 2. It uses same number of vehicles but visits more zones, OR
             // 3. It uses same vehicles, visits same zones, but has shorter duration
-            if (improved_cv_count < current_solution.getCVCount()) {
-              is_better = true;
-            } else if (improved_cv_count == current_solution.getCVCount()) {
-              if (improved_zones_count > current_solution.visitedZones(problem)) {
-                is_better = true;
-              } else if (improved_zones_count == current_solution.visitedZones(problem) &&
-                         improved_total_duration < current_solution.totalDuration()) {
-                is_better = true;
-              }
-            }
-
-            if (is_better) {
+            if (improved_solution.score().isBetterThan(current_solution.score())) {
               // Improvement found, reset available neighborhoods
-              current_solution = improved_solution;
+              current_solution = std::move(improved_solution);
               available_neighborhoods.resetAll();
+            } else if (cv_search != nullptr) {
+              // A CV route search that does not improve has no improving move left
+              available_neighborhoods.markExhausted(k, current_solution.lastStamp());
             } else {
               // No improvement, mark this neighborhood as unavailable
               available_neighborhoods.markUnavailable(k);
             }
           }
 
-          // Check if we found a new best solution - thread-safe update
-          {
-            std::lock_guard<std::mutex> lock(best_solution_mutex);
-
-            size_t current_cv_count = current_solution.getCVCount();
-            size_t current_zones_count = current_solution.visitedZones(problem);
-            Duration current_total_duration = current_solution.totalDuration();
-
-            bool is_new_best = false;
-            if (current_cv_count < best_cv_count) {
-              is_new_best = true;
-            } else if (current_cv_count == best_cv_count) {
-              if (current_zones_count > best_zones_count) {
-                is_new_best = true;
-              } else if (current_zones_count == best_zones_count &&
-                         current_total_duration < best_total_duration) {
-                is_new_best = true;
-              }
-            }
-
-            if (is_new_best) {
-              best_solution = current_solution;
-              best_cv_count = current_cv_count;
-              best_zones_count = current_zones_count;
-              best_total_duration = current_total_duration;
-            }
-          }
+          // Publish the local optimum if it beats the best solution found so far
+          incumbent_.offer(current_solution);
 
           // Shaking - perturb the current solution
           current_solution = shake(problem, current_solution, gen);
@@ -194,9 +168,14 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
     completion_latch.wait();
     // jthreads will automatically join when they go out of scope
 
-    return best_solution;
+    return incumbent_.snapshot().value_or(initial_solution);
   }
 
+  /**
+   * @brief Best solution found by the running or last solve, readable without blocking it
+   */
+  [[nodiscard]] const IncumbentStore& incumbent() const noexcept { return incumbent_; }
+
   /**
    * @brief Shake the current solution to escape local optima
    *
@@ -208,7 +187,7 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
   VRPTSolution shake(const VRPTProblem& problem, const VRPTSolution& solution, std::mt19937& gen) {
     // Copy the solution
     VRPTSolution new_solution = solution;
-    auto& routes = new_solution.getCVRoutes();
+    const auto& routes = new_solution.getCVRoutes();
 
     // Need at least two routes to perform shaking
     if (routes.size() < 2) {
@@ -224,22 +203,20 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
     } while (r1_idx == r2_idx);
 
     // Get route locations
-    const auto& r1_locs = routes[r1_idx].locationIds();
-    const auto& r2_locs = routes[r2_idx].locationIds();
+    const auto& r1_locs = routes[r1_idx].locations();
+    const auto& r2_locs = routes[r2_idx].locations();
 
     // Collect collection zones from both routes
-    std::vector<std::string> r1_zones, r2_zones;
-    for (const auto& loc_id : r1_locs) {
-      const auto& loc = problem.getLocation(loc_id);
-      if (loc.type() == LocationType::COLLECTION_ZONE) {
-        r1_zones.push_back(loc_id);
+    std::vector<LocationIndex> r1_zones, r2_zones;
+    for (const auto loc_index : r1_locs) {
+      if (problem.getLocationTable().type(loc_index) == LocationType::COLLECTION_ZONE) {
+        r1_zones.push_back(loc_index);
       }
     }
 
-    for (const auto& loc_id : r2_locs) {
-      const auto& loc = problem.getLocation(loc_id);
-      if (loc.type() == LocationType::COLLECTION_ZONE) {
-        r2_zones.push_back(loc_id);
+    for (const auto loc_index : r2_locs) {
+      if (problem.getLocationTable().type(loc_index) == LocationType::COLLECTION_ZONE) {
+        r2_zones.push_back(loc_index);
       }
     }
 
@@ -252,22 +229,22 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
     std::uniform_int_distribution<size_t> zone_dist1(0, r1_zones.size() - 1);
     std::uniform_int_distribution<size_t> zone_dist2(0, r2_zones.size() - 1);
 
-    std::string zone1 = r1_zones[zone_dist1(gen)];
-    std::string zone2 = r2_zones[zone_dist2(gen)];
+    LocationIndex zone1 = r1_zones[zone_dist1(gen)];
+    LocationIndex zone2 = r2_zones[zone_dist2(gen)];
 
     // Create new routes with zones swapped
-    std::vector<std::string> new_r1_locs, new_r2_locs;
-    for (const auto& loc_id : r1_locs) {
-      if (loc_id != zone1) {
-        new_r1_locs.push_back(loc_id);
+    std::vector<LocationIndex> new_r1_locs, new_r2_locs;
+    for (const auto loc_index : r1_locs) {
+      if (loc_index != zone1) {
+        new_r1_locs.push_back(loc_index);
       } else {
         new_r1_locs.push_back(zone2);
       }
     }
 
-    for (const auto& loc_id : r2_locs) {
-      if (loc_id != zone2) {
-        new_r2_locs.push_back(loc_id);
+    for (const auto loc_index : r2_locs) {
+      if (loc_index != zone2) {
+        new_r2_locs.push_back(loc_index);
       } else {
         new_r2_locs.push_back(zone1);
       }
@@ -279,34 +256,34 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
 
     // Create new routes - if not feasible, return original solution
     CVRoute new_r1(routes[r1_idx].vehicleId(), cv_capacity, cv_max_duration);
-    for (const auto& loc_id : new_r1_locs) {
-      if (!new_r1.canVisit(loc_id, problem)) {
+    for (const auto loc_index : new_r1_locs) {
+      if (!new_r1.canVisit(loc_index, problem)) {
         return solution;
       }
-      new_r1.addLocation(loc_id, problem);
+      new_r1.addLocation(loc_index, problem);
     }
 
     // Check if the first route ends at depot and has 0 load
-    if (new_r1.currentLoad().value() != 0.0 || new_r1.lastLocationId() != problem.getDepot().id()) {
+    if (new_r1.currentLoad().value() != 0.0 || new_r1.lastLocation() != problem.getDepotIndex()) {
       return solution;  // Return original solution if invalid
     }
 
     CVRoute new_r2(routes[r2_idx].vehicleId(), cv_capacity, cv_max_duration);
-    for (const auto& loc_id : new_r2_locs) {
-      if (!new_r2.canVisit(loc_id, problem)) {
+    for (const auto loc_index : new_r2_locs) {
+      if (!new_r2.canVisit(loc_index, problem)) {
         return solution;
       }
-      new_r2.addLocation(loc_id, problem);
+      new_r2.addLocation(loc_index, problem);
     }
 
     // Check if the second route ends at depot and has 0 load
-    if (new_r2.currentLoad().value() != 0.0 || new_r2.lastLocationId() != problem.getDepot().id()) {
+    if (new_r2.currentLoad().value() != 0.0 || new_r2.lastLocation() != problem.getDepotIndex()) {
       return solution;  // Return original solution if invalid
     }
 
     // Update routes
-    routes[r1_idx] = new_r1;
-    routes[r2_idx] = new_r2;
+    new_solution.replaceCVRoute(r1_idx, std::move(new_r1));
+    new_solution.replaceCVRoute(r2_idx, std::move(new_r2));
 
     return new_solution;
   }
@@ -340,6 +317,9 @@ class GVNS : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
   // Map to track neighborhood search instances by name for UI configuration
   std::unordered_map<std::string, ::meta::LocalSearch<VRPTSolution, VRPTProblem>*> search_map_;
 
+  // Best solution shared by the worker threads
+  IncumbentStore incumbent_;
+
   // Initialize/update components when configuration changes
   void initializeComponents() {
     using MetaFactory =
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "algorithms/solution_score.h"
+#include "algorithms/vrpt_solution.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class IncumbentStore
+ * @brief Best solution found so far, shared by search workers without a lock
+ *
+ * Workers offer every solution they finish. An offer is checked against an atomic packed score
+ * first, so the common non-improving case costs one atomic load and copies nothing. A strictly
+ * better solution is copied into a new entry and published by swapping the entry pointer.
+ *
+ * Entries are reclaimed with epoch-based protection (a simple RCU). A reader announces the
+ * current epoch in a reader slot before loading the pointer, and a replaced entry is only freed
+ * once every announced epoch is newer than the one it was retired in. Readers such as the GUI
+ * or progress reporters therefore never block workers, and workers never wait for readers.
+ */
+class IncumbentStore {
+ private:
+  struct Entry;
+
+ public:
+  // Readers and publishing workers that can hold an entry at the same time
+  static constexpr size_t max_readers = 128;
+
+  /**
+   * @brief Access to the published solution, valid while the guard lives
+   */
+  class ReadGuard {
+   public:
+    ReadGuard(ReadGuard&& other) noexcept
+        : slot_(std::exchange(other.slot_, nullptr)), entry_(other.entry_) {}
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+    ReadGuard& operator=(ReadGuard&&) = delete;
+    ~ReadGuard();
+
+    // Whether a solution has been published
+    [[nodiscard]] explicit operator bool() const noexcept { return entry_ != nullptr; }
+
+    [[nodiscard]] const VRPTSolution& operator*() const noexcept;
+    [[nodiscard]] const VRPTSolution* operator->() const noexcept { return &**this; }
+    [[nodiscard]] SolutionScore score() const noexcept;
+
+   private:
+    friend class IncumbentStore;
+
+    ReadGuard(std::atomic<uint64_t>* slot, const Entry* entry) noexcept
+        : slot_(slot), entry_(entry) {}
+
+    std::atomic<uint64_t>* slot_;
+    const Entry* entry_;
+  };
+
+  IncumbentStore() = default;
+  IncumbentStore(const IncumbentStore&) = delete;
+  IncumbentStore& operator=(const IncumbentStore&) = delete;
+
+  // No reader may be active when the store is destroyed
+  ~IncumbentStore();
+
+  /**
+   * @brief Publish a solution if it is strictly better than the incumbent
+   * @return True if the solution was published
+   */
+  bool offer(const VRPTSolution& candidate);
+
+  /**
+   * @brief Drop the incumbent, so the next offer is always published
+   */
+  void clear();
+
+  // Score of the incumbent, or the worst score if there is none
+  [[nodiscard]] SolutionScore bestScore() const noexcept { return best_score_.load(); }
+
+  // Whether a solution with this score would be published
+  [[nodiscard]] bool wouldImprove(SolutionScore score) const noexcept {
+    return score.isBetterThan(bestScore());
+  }
+
+  /**
+   * @brief Pin the incumbent for reading without copying it
+   */
+  [[nodiscard]] ReadGuard read() const;
+
+  /**
+   * @brief Copy of the incumbent, or nullopt if nothing has been published
+   */
+  [[nodiscard]] std::optional<VRPTSolution> snapshot() const;
+
+ private:
+  struct Entry {
+    SolutionScore score;
+    VRPTSolution solution;
+    uint64_t retired_at{0};  // Epoch in which the entry was replaced
+    Entry* next_retired{nullptr};
+  };
+
+  struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch{0};  // Epoch announced by the holder, 0 when free
+  };
+
+  std::atomic<SolutionScore> best_score_{};
+  std::atomic<Entry*> current_{nullptr};
+  std::atomic<uint64_t> epoch_{1};
+  mutable std::array<ReaderSlot, max_readers> readers_{};
+
+  // Replaced entries that may still be read, as a lock-free stack
+  std::atomic<Entry*> retired_{nullptr};
+  std::mutex reclaim_mutex_;  // Only ever try-locked, so reclamation never blocks
+
+  // Announce the current epoch in a free reader slot
+  [[nodiscard]] std::atomic<uint64_t>& enter() const;
+
+  void retire(Entry* entry);
+  void pushRetired(Entry* entry) noexcept;
+  void reclaim();
+};
+
+}  // namespace algorithm
+}  // namespace daa
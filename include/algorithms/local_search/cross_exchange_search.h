@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "algorithm_registry.h"
+#include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
+#include "algorithms/vrpt_solution.h"
+#include "meta_heuristic_factory.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @brief CROSS-exchange local search for CV routes
+ *
+ * Exchanges a run of up to three consecutive zones of one route with a run of up to three zones
+ * of another route, keeping their order. Runs never cross an SWTS visit, so every trip keeps its
+ * stop and only the load of the two trips involved changes. Candidates are evaluated by joining
+ * the prefix, the other run and the suffix RouteSegments of each route, in O(1).
+ */
+class CrossExchangeSearch : public CVLocalSearch {
+ public:
+  // Longest run of zones taken from each route
+  static constexpr size_t max_run_length = 3;
+
+  /**
+   * @brief Constructor with parameters
+   * @param max_iterations Maximum number of iterations
+   * @param first_improvement Whether to use first improvement
+   */
+  explicit CrossExchangeSearch(int max_iterations = 100, bool first_improvement = false)
+      : CVLocalSearch(max_iterations, first_improvement) {}
+
+  /**
+   * @brief Find the run exchange to apply
+   */
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
+    override {
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
+    const Capacity capacity = problem.getCVCapacity();
+
+    if (routes.size() < 2) {
+      return best_move;
+    }
+
+    // Suffix summaries and the runs starting at every position of every route
+    std::pmr::vector<std::pmr::vector<RouteSegment>> suffixes(sweep.resource());
+    std::pmr::vector<std::pmr::vector<Runs>> runs(sweep.resource());
+    suffixes.reserve(routes.size());
+    runs.reserve(routes.size());
+    for (const auto& route : routes) {
+      suffixes.push_back(route.suffixes(problem, sweep.resource()));
+      runs.push_back(routeRuns(route, problem, sweep.resource()));
+    }
+
+    for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
+      const auto& r1 = routes[r1_idx];
+
+      for (const auto& trip1 : r1.trips()) {
+        for (size_t pos1 = trip1.begin; pos1 < trip1.zonesEnd(); ++pos1) {
+          const auto& runs1 = runs[r1_idx][pos1];
+
+          for (size_t r2_idx = r1_idx + 1; r2_idx < routes.size(); ++r2_idx) {
+            if (!isChanged(current_solution, r1_idx) && !isChanged(current_solution, r2_idx)) {
+              continue;
+            }
+
+            const auto& r2 = routes[r2_idx];
+            for (const auto& trip2 : r2.trips()) {
+              for (size_t pos2 = trip2.begin; pos2 < trip2.zonesEnd(); ++pos2) {
+                const auto& runs2 = runs[r2_idx][pos2];
+
+                for (size_t length1 = 1; length1 <= runs1.count; ++length1) {
+                  const Capacity load1 = runs1.segments[length1 - 1].headLoad();
+
+                  for (size_t length2 = 1; length2 <= runs2.count; ++length2) {
+                    const Capacity load2 = runs2.segments[length2 - 1].headLoad();
+
+                    // Both trips must still fit in the vehicle after the exchange
+                    if (trip1.load - load1 + load2 > capacity ||
+                        trip2.load - load2 + load1 > capacity) {
+                      continue;
+                    }
+
+                    const auto new_r1 = RouteSegment::route(
+                      problem,
+                      r1.prefix(pos1),
+                      runs2.segments[length2 - 1],
+                      suffixes[r1_idx][pos1 + length1]
+                    );
+                    const auto new_r2 = RouteSegment::route(
+                      problem,
+                      r2.prefix(pos2),
+                      runs1.segments[length1 - 1],
+                      suffixes[r2_idx][pos2 + length2]
+                    );
+                    auto move =
+                      Move::crossExchange(r1_idx, pos1, length1, r2_idx, pos2, length2);
+                    move.evaluate(problem, current_solution, new_r1, new_r2);
+
+                    if (isImprovement(move, best_move)) {
+                      best_move = move;
+
+                      if (first_improvement_) {
+                        return best_move;
+                      }
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return best_move;
+  }
+
+  std::string name() const override { return "Cross Exchange Search"; }
+
+ private:
+  // The runs starting at one position: entry k covers k + 1 zones of the same trip, so its head
+  // load is all of its waste
+  struct Runs {
+    std::array<RouteSegment, max_run_length> segments{};
+    size_t count{0};
+  };
+
+  // Runs starting at every zone of the route, indexed by position
+  [[nodiscard]] static std::pmr::vector<Runs> routeRuns(
+    const CVRoute& route,
+    const VRPTProblem& problem,
+    std::pmr::memory_resource* resource
+  ) {
+    const auto& locations = route.locations();
+    std::pmr::vector<Runs> result(locations.size(), resource);
+
+    for (const auto& trip : route.trips()) {
+      for (size_t pos = trip.begin; pos < trip.zonesEnd(); ++pos) {
+        auto& runs = result[pos];
+        RouteSegment segment;
+        for (size_t k = pos; k < trip.zonesEnd() && runs.count < max_run_length; ++k) {
+          segment =
+            RouteSegment::concat(segment, RouteSegment::single(locations[k], problem), problem);
+          runs.segments[runs.count++] = segment;
+        }
+      }
+    }
+    return result;
+  }
+};
+
+namespace {
+inline static const bool CrossExchangeSearch_registered_gen =
+  MetaHeuristicFactory<VRPTSolution, VRPTProblem, TypedAlgorithm<VRPTProblem, VRPTSolution>>::
+    registerSearch<CrossExchangeSearch>("CrossExchangeSearch");
+}
+
+}  // namespace algorithm
+}  // namespace daa
@@ -1,6 +1,10 @@
 #pragma once
 
-#include <unordered_set>
+#include <cstdint>
+#include <optional>
+
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
 #include "algorithms/vrpt_solution.h"
 #include "imgui.h"
 #include "meta_heuristic_components.h"
@@ -29,6 +33,10 @@ class CVLocalSearch : public ::meta::LocalSearch<VRPTSolution, VRPTProblem> {
 
   /**
    * @brief Improve an existing solution using local search
+   *
+   * Repeatedly applies the move the neighborhood settles on until none improves the solution
+   * or the iteration limit is reached. Only improving moves are returned, so no full-solution
+   * comparison is needed. The scratch memory of each sweep is released once its move is applied.
    * @param problem The problem instance
    * @param initial_solution The initial solution to improve
    * @return The improved solution
@@ -36,82 +44,70 @@ class CVLocalSearch : public ::meta::LocalSearch<VRPTSolution, VRPTProblem> {
   VRPTSolution improveSolution(const VRPTProblem& problem, const VRPTSolution& initial_solution)
     override {
     auto current_solution = initial_solution;
-    auto best_solution = current_solution;
-
-    // Store solution metrics for comparison
-    struct SolutionMetrics {
-      size_t cv_count;
-      size_t zones_count;
-      double total_duration;
-    };
-
-    auto getSolutionMetrics = [&problem](const VRPTSolution& solution) -> SolutionMetrics {
-      return {
-        .cv_count = solution.getCVCount(),
-        .zones_count = solution.visitedZones(problem),
-        .total_duration = solution.totalDuration().value()
-      };
-    };
-
-    const auto max_cv_vehicles = problem.getNumCVVehicles();
-    auto best_metrics = getSolutionMetrics(best_solution);
-
-    auto is_better_solution =
-      [max_cv_vehicles](const SolutionMetrics& current, const SolutionMetrics& candidate) -> bool {
-      // First constraint: Use at most the maximum number of allowed vehicles
-      if (current.cv_count > static_cast<size_t>(max_cv_vehicles) &&
-          candidate.cv_count <= static_cast<size_t>(max_cv_vehicles)) {
-        return true;  // Candidate satisfies vehicle constraint while current doesn't
-      }
-
-      if ((current.cv_count > static_cast<size_t>(max_cv_vehicles) &&
-           candidate.cv_count < current.cv_count) ||
-          (current.cv_count <= static_cast<size_t>(max_cv_vehicles) &&
-           candidate.cv_count < current.cv_count &&
-           candidate.cv_count <= static_cast<size_t>(max_cv_vehicles))) {
-        return true;  // Fewer vehicles while respecting constraints
-      }
-
-      if (current.cv_count == candidate.cv_count) {
-        // Same number of vehicles, check zones count
-        if (candidate.zones_count > current.zones_count) {
-          return true;  // More zones visited
-        }
-
-        if (candidate.zones_count == current.zones_count &&
-            candidate.total_duration < current.total_duration) {
-          return true;  // Same zones with better duration
-        }
-      }
-
-      return false;
-    };
 
     for (int iteration = 0; iteration < max_iterations_; ++iteration) {
-      auto neighbor_solution = searchNeighborhood(problem, current_solution);
-      auto neighbor_metrics = getSolutionMetrics(neighbor_solution);
-
-      if (is_better_solution(best_metrics, neighbor_metrics)) {
-        best_solution = neighbor_solution;
-        best_metrics = neighbor_metrics;
-        current_solution = std::move(neighbor_solution);
-      } else {
-        // No improvement found
-        break;
+      SearchArena::Scope sweep;
+      const auto move = findMove(problem, current_solution);
+      if (!move) {
+        break;  // No improvement found
       }
+      move->apply(current_solution, problem);
     }
 
-    return best_solution;
+    return current_solution;
   }
 
+  /**
+   * @brief Improve a solution, trying only moves that touch routes changed after a stamp
+   *
+   * Whether a move improves depends only on the routes it touches. If this neighborhood found
+   * no improving move in an earlier solution whose lastStamp() was `changed_since`, moves among
+   * routes not replaced since then still cannot improve, so only moves touching a route with a
+   * later stamp are tried. The result is the same as improveSolution() would give.
+   * @param problem The problem instance
+   * @param initial_solution The solution to improve, descended from the earlier one
+   * @param changed_since Last stamp of the solution the neighborhood was exhausted in
+   * @return The improved solution
+   */
+  VRPTSolution improveChangedRoutes(
+    const VRPTProblem& problem,
+    const VRPTSolution& initial_solution,
+    uint64_t changed_since
+  ) {
+    changed_since_ = changed_since;
+    auto result = improveSolution(problem, initial_solution);
+    changed_since_ = 0;
+    return result;
+  }
+
+  /**
+   * @brief Find the improving move to apply next
+   *
+   * With first improvement this is the first improving move found, otherwise the best one.
+   * Moves touching no changed route (see isChanged()) are skipped. Scratch buffers come from
+   * the thread's SearchArena, inside a SearchArena::Scope.
+   * @param problem The problem instance
+   * @param current_solution The current solution
+   * @return The move, or nullopt if no move improves the solution
+   */
+  [[nodiscard]] virtual std::optional<Move>
+    findMove(const VRPTProblem& problem, const VRPTSolution& current_solution) = 0;
+
   /**
    * @brief Search the neighborhood for an improved solution
    * @param problem The problem instance
    * @param current_solution The current solution
-   * @return The best neighboring solution found
+   * @return The best neighboring solution found, or the current one if none improves it
    */
-  virtual VRPTSolution
-    searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution) = 0;
+  VRPTSolution
+    searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution) {
+    SearchArena::Scope sweep;
+    auto neighbor_solution = current_solution;
+    if (const auto move = findMove(problem, current_solution)) {
+      move->apply(neighbor_solution, problem);
+    }
+    return neighbor_solution;
+  }
 
   /**
    * @brief Render UI elements for configuring this local search algorithm
@@ -122,8 +118,32 @@ class CVLocalSearch : public ::meta::LocalSearch<VRPTSolution, VRPTProblem> {
   }
 
  protected:
+  /**
+   * @brief Whether a feasible move improves on the best one found so far
+   *
+   * A move must not add vehicles compared to the best move (or to the current solution when
+   * there is none yet) and must shorten the total duration further. Moves keep every location,
+   * so the zones visited never change.
+   */
+  [[nodiscard]] static bool isImprovement(const Move& move, const std::optional<Move>& best) {
+    const int best_vehicle_delta = best ? best->vehicleDelta() : 0;
+    const Duration best_delta = best ? best->delta() : Duration{};
+    return move.isFeasible() && move.vehicleDelta() <= best_vehicle_delta &&
+           move.delta() < best_delta;
+  }
+
+  /**
+   * @brief Whether moves touching the route at an index can improve the solution
+   *
+   * False for routes left unchanged since the stamp given to improveChangedRoutes().
+   */
+  [[nodiscard]] bool isChanged(const VRPTSolution& solution, size_t route) const {
+    return solution.cvRouteStamp(route) > changed_since_;
+  }
+
   int max_iterations_ = 100;
   bool first_improvement_ = false;
+  uint64_t changed_since_ = 0;  // Routes stamped up to this hold no improving move
 };
 
 }  // namespace algorithm
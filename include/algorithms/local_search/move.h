@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
+#include "algorithms/swts_placement.h"
+#include "algorithms/vrpt_solution.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class Move
+ * @brief A candidate change to at most two CV routes of a solution
+ *
+ * Neighborhoods describe candidates as moves instead of modified copies of the solution. A
+ * move records which routes and positions it touches, and its evaluation: the change in total
+ * duration and in vehicles used, and whether the touched routes stay feasible. The evaluation
+ * comes from the RouteSegment summaries of the touched routes only, so it costs O(1). Only the
+ * move a search settles on is applied, rebuilding just the routes it touches.
+ *
+ * Positions refer to the solution the move was found in, and stay valid until a move is applied
+ * to it.
+ */
+class Move {
+ public:
+  enum class Kind {
+    Relocate,       // Move the zone at (route1, pos1) before position pos2 of route2
+    Swap,           // Exchange the zones at (route1, pos1) and (route2, pos2)
+    TwoOpt,         // Reverse the locations at positions pos1 + 1 .. pos2 of route1
+    OrOpt,          // Move the length() locations from (route1, pos1) before pos2 of route2
+    CrossExchange,  // Exchange length() locations at (route1, pos1) with secondLength() at
+                    // (route2, pos2)
+    ReassignSWTS    // Break the trips of route1 and unload them where SWTSPlacement finds best
+  };
+
+  [[nodiscard]] static Move
+    relocate(size_t from_route, size_t from_pos, size_t to_route, size_t to_pos) {
+    return {Kind::Relocate, from_route, from_pos, to_route, to_pos};
+  }
+
+  [[nodiscard]] static Move swap(size_t route1, size_t pos1, size_t route2, size_t pos2) {
+    return {Kind::Swap, route1, pos1, route2, pos2};
+  }
+
+  [[nodiscard]] static Move twoOpt(size_t route, size_t i, size_t j) {
+    return {Kind::TwoOpt, route, i, route, j};
+  }
+
+  /**
+   * @brief Move a chain of consecutive locations, optionally reversing it
+   *
+   * Within one route, to_pos must lie outside from_pos .. from_pos + length.
+   */
+  [[nodiscard]] static Move orOpt(
+    size_t from_route,
+    size_t from_pos,
+    size_t length,
+    size_t to_route,
+    size_t to_pos,
+    bool reversed
+  ) {
+    Move move{Kind::OrOpt, from_route, from_pos, to_route, to_pos};
+    move.length_ = length;
+    move.reversed_ = reversed;
+    return move;
+  }
+
+  /**
+   * @brief Exchange a run of locations of one route with a run of locations of another
+   *
+   * Runs reaching the end of their routes exchange the route tails, as in 2-opt*. A route left
+   * without collection zones is emptied.
+   */
+  [[nodiscard]] static Move crossExchange(
+    size_t route1,
+    size_t pos1,
+    size_t length1,
+    size_t route2,
+    size_t pos2,
+    size_t length2
+  ) {
+    Move move{Kind::CrossExchange, route1, pos1, route2, pos2};
+    move.length_ = length1;
+    move.second_length_ = length2;
+    return move;
+  }
+
+  /**
+   * @brief Replace the trip breaks and SWTS visits of a route by its SWTSPlacement
+   *
+   * The placement is computed again when the move is applied.
+   */
+  [[nodiscard]] static Move reassignSWTS(size_t route) {
+    return {Kind::ReassignSWTS, route, 0, route, 0};
+  }
+
+  /**
+   * @brief Record the evaluation of a move touching a single route
+   * @param solution The solution the move was found in
+   * @param new_route Summary of the route after the move, built with RouteSegment::route
+   */
+  Move& evaluate(
+    const VRPTProblem& problem,
+    const VRPTSolution& solution,
+    const RouteSegment& new_route
+  ) {
+    const auto& route = solution.getCVRoutes()[route1_];
+    feasible_ = new_route.isFeasibleRoute(problem);
+    delta_ = new_route.duration() - route.totalDuration();
+    vehicle_delta_ = usedDelta(route, new_route);
+    return *this;
+  }
+
+  /**
+   * @brief Record the evaluation of a move touching two routes
+   * @param new_route1 Summary of route1 after the move
+   * @param new_route2 Summary of route2 after the move
+   */
+  Move& evaluate(
+    const VRPTProblem& problem,
+    const VRPTSolution& solution,
+    const RouteSegment& new_route1,
+    const RouteSegment& new_route2
+  ) {
+    const auto& route1 = solution.getCVRoutes()[route1_];
+    const auto& route2 = solution.getCVRoutes()[route2_];
+    feasible_ = new_route1.isFeasibleRoute(problem) && new_route2.isFeasibleRoute(problem);
+    delta_ = new_route1.duration() - route1.totalDuration() + new_route2.duration() -
+             route2.totalDuration();
+    vehicle_delta_ = usedDelta(route1, new_route1) + usedDelta(route2, new_route2);
+    return *this;
+  }
+
+  /**
+   * @brief Apply the move, rebuilding the touched routes
+   *
+   * Routes left empty are removed from the solution.
+   */
+  void apply(VRPTSolution& solution, const VRPTProblem& problem) const {
+    SearchArena::Scope scratch;
+    const auto& routes = solution.getCVRoutes();
+    const auto& old_locations1 = routes[route1_].locations();
+    std::pmr::vector<LocationIndex> locations1(
+      old_locations1.begin(), old_locations1.end(), scratch.resource()
+    );
+
+    switch (kind_) {
+      case Kind::Relocate: {
+        const LocationIndex zone = locations1[pos1_];
+        if (route1_ == route2_) {
+          locations1.erase(locations1.begin() + pos1_);
+          locations1.insert(locations1.begin() + (pos2_ > pos1_ ? pos2_ - 1 : pos2_), zone);
+        } else {
+          const auto& old_locations2 = routes[route2_].locations();
+          std::pmr::vector<LocationIndex> locations2(
+            old_locations2.begin(), old_locations2.end(), scratch.resource()
+          );
+          locations1.erase(locations1.begin() + pos1_);
+          locations2.insert(locations2.begin() + pos2_, zone);
+          solution.replaceCVRoute(route2_, rebuildRoute(routes[route2_], locations2, problem));
+        }
+        break;
+      }
+      case Kind::Swap:
+        if (route1_ == route2_) {
+          std::swap(locations1[pos1_], locations1[pos2_]);
+        } else {
+          const auto& old_locations2 = routes[route2_].locations();
+          std::pmr::vector<LocationIndex> locations2(
+            old_locations2.begin(), old_locations2.end(), scratch.resource()
+          );
+          std::swap(locations1[pos1_], locations2[pos2_]);
+          solution.replaceCVRoute(route2_, rebuildRoute(routes[route2_], locations2, problem));
+        }
+        break;
+      case Kind::TwoOpt:
+        std::reverse(locations1.begin() + pos1_ + 1, locations1.begin() + pos2_ + 1);
+        break;
+      case Kind::OrOpt: {
+        const auto first = locations1.begin() + pos1_;
+        std::pmr::vector<LocationIndex> chain(first, first + length_, scratch.resource());
+        if (reversed_) {
+          std::reverse(chain.begin(), chain.end());
+        }
+        locations1.erase(first, first + length_);
+
+        if (route1_ == route2_) {
+          const size_t to = pos2_ > pos1_ ? pos2_ - length_ : pos2_;
+          locations1.insert(locations1.begin() + to, chain.begin(), chain.end());
+        } else {
+          const auto& old_locations2 = routes[route2_].locations();
+          std::pmr::vector<LocationIndex> locations2(
+            old_locations2.begin(), old_locations2.end(), scratch.resource()
+          );
+          locations2.insert(locations2.begin() + pos2_, chain.begin(), chain.end());
+          solution.replaceCVRoute(route2_, rebuildRoute(routes[route2_], locations2, problem));
+        }
+        break;
+      }
+      case Kind::CrossExchange: {
+        const auto& old_locations2 = routes[route2_].locations();
+        const auto run1 = old_locations1.begin() + pos1_;
+        const auto run2 = old_locations2.begin() + pos2_;
+        std::pmr::vector<LocationIndex> locations2(
+          old_locations2.begin(), run2, scratch.resource()
+        );
+        locations2.insert(locations2.end(), run1, run1 + length_);
+        locations2.insert(locations2.end(), run2 + second_length_, old_locations2.end());
+
+        locations1.erase(locations1.begin() + pos1_, locations1.begin() + pos1_ + length_);
+        locations1.insert(locations1.begin() + pos1_, run2, run2 + second_length_);
+
+        clearWithoutZones(locations1, problem);
+        clearWithoutZones(locations2, problem);
+        solution.replaceCVRoute(route2_, rebuildRoute(routes[route2_], locations2, problem));
+        break;
+      }
+      case Kind::ReassignSWTS:
+        if (const auto placement = SWTSPlacement::optimal(routes[route1_].zones(), problem)) {
+          locations1.assign(placement->locations().begin(), placement->locations().end());
+        }
+        break;
+    }
+    solution.replaceCVRoute(route1_, rebuildRoute(routes[route1_], locations1, problem));
+    solution.removeEmptyCVRoutes();
+  }
+
+  [[nodiscard]] Kind kind() const noexcept { return kind_; }
+  [[nodiscard]] size_t route1() const noexcept { return route1_; }
+  [[nodiscard]] size_t pos1() const noexcept { return pos1_; }
+  [[nodiscard]] size_t route2() const noexcept { return route2_; }
+  [[nodiscard]] size_t pos2() const noexcept { return pos2_; }
+
+  // Locations moved from route1 by an Or-opt or cross exchange move, and whether an Or-opt
+  // chain is inserted in reverse
+  [[nodiscard]] size_t length() const noexcept { return length_; }
+  [[nodiscard]] bool isReversed() const noexcept { return reversed_; }
+
+  // Locations moved from route2 by a cross exchange move
+  [[nodiscard]] size_t secondLength() const noexcept { return second_length_; }
+
+  // Whether every touched route stays feasible
+  [[nodiscard]] bool isFeasible() const noexcept { return feasible_; }
+
+  // Change in total CV route duration
+  [[nodiscard]] Duration delta() const noexcept { return delta_; }
+
+  // Change in the number of routes that visit at least one location
+  [[nodiscard]] int vehicleDelta() const noexcept { return vehicle_delta_; }
+
+  /**
+   * @brief Rebuild a route over a new location sequence
+   *
+   * Meant for sequences already accepted by RouteSegment::isFeasibleRoute, so every location is
+   * visitable and none is skipped.
+   */
+  [[nodiscard]] static CVRoute rebuildRoute(
+    const CVRoute& route,
+    std::span<const LocationIndex> locations,
+    const VRPTProblem& problem
+  ) {
+    CVRoute new_route(route.vehicleId(), problem.getCVCapacity(), problem.getCVMaxDuration());
+    for (const auto loc : locations) {
+      new_route.addLocation(loc, problem);
+    }
+    return new_route;
+  }
+
+ private:
+  Move(Kind kind, size_t route1, size_t pos1, size_t route2, size_t pos2)
+      : kind_(kind), route1_(route1), pos1_(pos1), route2_(route2), pos2_(pos2) {}
+
+  // Emptied routes stop counting as used vehicles
+  [[nodiscard]] static int usedDelta(const CVRoute& route, const RouteSegment& new_route) {
+    return (new_route.size() == 0 ? 0 : 1) - (route.isEmpty() ? 0 : 1);
+  }
+
+  // A route left with only stops serves nothing and is dropped
+  static void
+    clearWithoutZones(std::pmr::vector<LocationIndex>& locations, const VRPTProblem& problem) {
+    const auto& table = problem.getLocationTable();
+    if (std::none_of(locations.begin(), locations.end(), [&](LocationIndex location) {
+          return table.type(location) == LocationType::COLLECTION_ZONE;
+        })) {
+      locations.clear();
+    }
+  }
+
+  Kind kind_;
+  size_t route1_;
+  size_t pos1_;
+  size_t route2_;
+  size_t pos2_;
+  size_t length_{1};
+  size_t second_length_{1};
+  bool reversed_{false};
+  Duration delta_{};
+  int vehicle_delta_{0};
+  bool feasible_{false};
+};
+
+}  // namespace algorithm
+}  // namespace daa
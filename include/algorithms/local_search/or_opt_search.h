@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "algorithm_registry.h"
+#include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
+#include "algorithms/vrpt_solution.h"
+#include "meta_heuristic_factory.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @brief Or-opt local search for CV routes
+ *
+ * Moves a chain of up to three consecutive zones of one trip to another position of the same
+ * route or of a different route, inserting it as is or reversed. Routes are summarized by their
+ * prefix and suffix RouteSegments, which carry the cumulative time and load of the route, and
+ * the chain grows one zone at a time, so each candidate is evaluated and checked for
+ * feasibility in O(1).
+ */
+class OrOptSearch : public CVLocalSearch {
+ public:
+  // Longest chain of zones moved at once
+  static constexpr size_t max_chain_length = 3;
+
+  /**
+   * @brief Constructor with parameters
+   * @param max_iterations Maximum number of iterations
+   * @param first_improvement Whether to use first improvement
+   */
+  explicit OrOptSearch(int max_iterations = 100, bool first_improvement = false)
+      : CVLocalSearch(max_iterations, first_improvement) {}
+
+  /**
+   * @brief Find the chain relocation to apply
+   */
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
+    override {
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
+    const auto& table = problem.getLocationTable();
+    const Capacity capacity = problem.getCVCapacity();
+
+    // Keep a move that improves on the best one, telling whether the search can stop
+    const auto keep = [&](const Move& move) {
+      if (!isImprovement(move, best_move)) {
+        return false;
+      }
+      best_move = move;
+      return first_improvement_;
+    };
+
+    // Suffix summaries of every route, so candidates are evaluated without building them
+    std::pmr::vector<std::pmr::vector<RouteSegment>> suffixes(sweep.resource());
+    suffixes.reserve(routes.size());
+    for (const auto& route : routes) {
+      suffixes.push_back(route.suffixes(problem, sweep.resource()));
+    }
+
+    // Summaries of the locations from each position up to the chain, reused per chain start
+    std::pmr::vector<RouteSegment> before(sweep.resource());
+
+    for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
+      const auto& r1 = routes[r1_idx];
+      const auto& locations1 = r1.locations();
+      const auto& trips1 = r1.trips();
+
+      for (size_t t1 = 0; t1 < trips1.size(); ++t1) {
+        for (size_t pos1 = trips1[t1].begin; pos1 < trips1[t1].zonesEnd(); ++pos1) {
+          // before[k] covers positions [k, pos1)
+          if (isChanged(current_solution, r1_idx)) {
+            before.assign(pos1 + 1, RouteSegment{});
+            for (size_t k = pos1; k-- > 0;) {
+              const auto location = RouteSegment::single(locations1[k], problem);
+              before[k] = RouteSegment::concat(location, before[k + 1], problem);
+            }
+          }
+
+          // The chain in visit order and reversed, and the waste it holds
+          RouteSegment forward;
+          RouteSegment backward;
+          Capacity load{0.0};
+
+          for (size_t length = 1;
+               length <= max_chain_length && pos1 + length <= trips1[t1].zonesEnd();
+               ++length) {
+            const LocationIndex last = locations1[pos1 + length - 1];
+            const auto location = RouteSegment::single(last, problem);
+            forward = RouteSegment::concat(forward, location, problem);
+            backward = RouteSegment::concat(location, backward, problem);
+            load = load + table.wasteAmount(last);
+            const size_t end1 = pos1 + length;
+
+            // Reversing a single zone changes nothing
+            const size_t orientations = length > 1 ? 2 : 1;
+
+            // Into another route: the first route without the chain does not depend on where
+            // it goes, and the chain joins the trip holding the position it is inserted before
+            const auto new_r1 =
+              RouteSegment::route(problem, r1.prefix(pos1), suffixes[r1_idx][end1]);
+            const bool r1_feasible = new_r1.isFeasibleRoute(problem);
+
+            for (size_t r2_idx = 0; r2_idx < routes.size(); ++r2_idx) {
+              if (!r1_feasible || r1_idx == r2_idx ||
+                  (!isChanged(current_solution, r1_idx) && !isChanged(current_solution, r2_idx))) {
+                continue;
+              }
+
+              const auto& r2 = routes[r2_idx];
+              for (const auto& trip2 : r2.trips()) {
+                if (trip2.load + load > capacity) {
+                  continue;
+                }
+
+                for (size_t pos2 = trip2.begin; pos2 < trip2.end; ++pos2) {
+                  for (size_t o = 0; o < orientations; ++o) {
+                    const auto& chain = o == 0 ? forward : backward;
+                    const auto new_r2 =
+                      RouteSegment::route(problem, r2.prefix(pos2), chain, suffixes[r2_idx][pos2]);
+                    auto move = Move::orOpt(r1_idx, pos1, length, r2_idx, pos2, o == 1);
+                    move.evaluate(problem, current_solution, new_r1, new_r2);
+                    if (keep(move)) {
+                      return best_move;
+                    }
+                  }
+                }
+              }
+            }
+
+            if (!isChanged(current_solution, r1_idx)) {
+              continue;
+            }
+
+            // Within the route, before or after the chain. Locations between the chain and
+            // the insertion point when moving it forward:
+            RouteSegment middle;
+
+            size_t t2 = 0;
+            for (size_t pos2 = 0; pos2 < locations1.size(); ++pos2) {
+              if (pos2 > end1) {
+                const auto between = RouteSegment::single(locations1[pos2 - 1], problem);
+                middle = RouteSegment::concat(middle, between, problem);
+              }
+              if (pos2 == trips1[t2].end) {
+                ++t2;
+              }
+
+              // Inserting the chain next to itself leaves the route as it is
+              if (pos2 >= pos1 && pos2 <= end1) {
+                continue;
+              }
+
+              // Another trip must have room for the chain
+              if (t2 != t1 && trips1[t2].load + load > capacity) {
+                continue;
+              }
+
+              for (size_t o = 0; o < orientations; ++o) {
+                const auto& chain = o == 0 ? forward : backward;
+                const auto& suffix = suffixes[r1_idx];
+                const auto new_route =
+                  pos2 < pos1
+                    ? RouteSegment::route(
+                        problem, r1.prefix(pos2), chain, before[pos2], suffix[end1]
+                      )
+                    : RouteSegment::route(problem, r1.prefix(pos1), middle, chain, suffix[pos2]);
+                auto move = Move::orOpt(r1_idx, pos1, length, r1_idx, pos2, o == 1);
+                move.evaluate(problem, current_solution, new_route);
+                if (keep(move)) {
+                  return best_move;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return best_move;
+  }
+
+  std::string name() const override { return "Or-Opt Search"; }
+};
+
+namespace {
+inline static const bool OrOptSearch_registered_gen =
+  MetaHeuristicFactory<VRPTSolution, VRPTProblem, TypedAlgorithm<VRPTProblem, VRPTSolution>>::
+    registerSearch<OrOptSearch>("OrOptSearch");
+}
+
+}  // namespace algorithm
+}  // namespace daa
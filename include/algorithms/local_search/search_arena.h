@@ -0,0 +1,199 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class SearchArena
+ * @brief Per-thread monotonic memory for the scratch buffers of a neighborhood sweep
+ *
+ * Local searches allocate short-lived buffers (segment summaries, location sequences) for every
+ * sweep. Taking them from the general heap makes worker threads contend inside malloc, so each
+ * thread bumps them out of its own monotonic arena instead, and the arena is rewound after every
+ * sweep. Memory handed out by the arena must not outlive the sweep; routes kept in a solution
+ * outlive it and are shared across threads, so they are allocated normally.
+ *
+ * Each arena counts how many allocations it served and how many blocks it had to take from the
+ * heap, for benchmarking. The counters belong to the arena's thread, so counting adds no shared
+ * writes to the sweep; stats() sums them over the live arenas and those of finished threads.
+ * resetStats() never writes them either: it records the counts of each arena as a baseline that
+ * stats() subtracts.
+ */
+class SearchArena {
+ public:
+  struct Stats {
+    uint64_t allocations{0};       // Allocations served by an arena
+    uint64_t bytes{0};             // Bytes handed out by arenas
+    uint64_t heap_allocations{0};  // Blocks arenas allocated on the heap
+  };
+
+  SearchArena(const SearchArena&) = delete;
+  SearchArena& operator=(const SearchArena&) = delete;
+
+  ~SearchArena() {
+    auto& arenas = registry();
+    const std::lock_guard lock(arenas.mutex);
+    add(arenas.retired, countedSinceReset());
+    std::erase(arenas.live, this);
+  }
+
+  // The arena of the calling thread
+  [[nodiscard]] static SearchArena& local() {
+    thread_local SearchArena arena;
+    return arena;
+  }
+
+  [[nodiscard]] std::pmr::memory_resource* resource() noexcept { return &counted_; }
+
+  // Free everything allocated since the last reset, keeping the initial buffer
+  void reset() { arena_.release(); }
+
+  /**
+   * @brief A sweep using the arena of the calling thread
+   *
+   * Scopes nest: the arena is rewound when the outermost one ends, so a sweep can call code that
+   * opens its own scope without losing its buffers.
+   */
+  class Scope {
+   public:
+    Scope() : arena_(local()) { ++arena_.depth_; }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope() {
+      if (--arena_.depth_ == 0) {
+        arena_.reset();
+      }
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() noexcept { return arena_.resource(); }
+
+   private:
+    SearchArena& arena_;
+  };
+
+  [[nodiscard]] static Stats stats() {
+    auto& arenas = registry();
+    const std::lock_guard lock(arenas.mutex);
+    Stats total = arenas.retired;
+    for (const auto* arena : arenas.live) {
+      add(total, arena->countedSinceReset());
+    }
+    return total;
+  }
+
+  static void resetStats() {
+    auto& arenas = registry();
+    const std::lock_guard lock(arenas.mutex);
+    arenas.retired = Stats{};
+    for (auto* arena : arenas.live) {
+      arena->baseline_ = arena->counted();
+    }
+  }
+
+ private:
+  static constexpr size_t initial_size = 64 * 1024;
+
+  // Counters of one arena. Only its thread writes them; atomics let stats() read them meanwhile.
+  struct Counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> heap_allocations{0};
+  };
+
+  // Counts the requests passing through to another resource
+  class CountingResource : public std::pmr::memory_resource {
+   public:
+    CountingResource(std::pmr::memory_resource* upstream, Counters& counters, bool heap) noexcept
+        : upstream_(upstream), counters_(counters), heap_(heap) {}
+
+   private:
+    // A single writer, so a plain load and store is enough and keeps the cache line local
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) noexcept {
+      counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+      if (heap_) {
+        bump(counters_.heap_allocations, 1);
+      } else {
+        bump(counters_.allocations, 1);
+        bump(counters_.bytes, bytes);
+      }
+      return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+      upstream_->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    Counters& counters_;
+    bool heap_;
+  };
+
+  // Arenas of the running threads, and the counts of those whose thread has finished
+  struct Registry {
+    std::mutex mutex;
+    std::vector<SearchArena*> live;
+    Stats retired;
+  };
+
+  [[nodiscard]] static Registry& registry() {
+    static Registry instance;
+    return instance;
+  }
+
+  static void add(Stats& total, const Stats& counts) noexcept {
+    total.allocations += counts.allocations;
+    total.bytes += counts.bytes;
+    total.heap_allocations += counts.heap_allocations;
+  }
+
+  // Counts since the arena was created
+  [[nodiscard]] Stats counted() const noexcept {
+    return {
+      counters_.allocations.load(std::memory_order_relaxed),
+      counters_.bytes.load(std::memory_order_relaxed),
+      counters_.heap_allocations.load(std::memory_order_relaxed),
+    };
+  }
+
+  // Counts since the last resetStats(); the registry mutex guards the baseline
+  [[nodiscard]] Stats countedSinceReset() const noexcept {
+    const Stats now = counted();
+    return {
+      now.allocations - baseline_.allocations,
+      now.bytes - baseline_.bytes,
+      now.heap_allocations - baseline_.heap_allocations,
+    };
+  }
+
+  SearchArena() {
+    auto& arenas = registry();
+    const std::lock_guard lock(arenas.mutex);
+    arenas.live.push_back(this);
+  }
+
+  Counters counters_;
+  Stats baseline_;  // Counts at the last resetStats()
+  std::unique_ptr<std::byte[]> buffer_{new std::byte[initial_size]};  // Kept across resets
+  CountingResource heap_{std::pmr::new_delete_resource(), counters_, true};
+  std::pmr::monotonic_buffer_resource arena_{buffer_.get(), initial_size, &heap_};
+  CountingResource counted_{&arena_, counters_, false};
+  int depth_{0};  // Open scopes
+};
+
+}  // namespace algorithm
+}  // namespace daa
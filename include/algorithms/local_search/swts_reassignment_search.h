@@ -0,0 +1,105 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "algorithm_registry.h"
+#include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
+#include "algorithms/swts_placement.h"
+#include "algorithms/vrpt_solution.h"
+#include "meta_heuristic_factory.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @brief SWTS reassignment local search for CV routes
+ *
+ * Keeps the zone order of each route and moves its trip breaks and unloading stops to where
+ * SWTSPlacement finds the shortest route. The other neighborhoods never change which SWTS a trip
+ * unloads at, so this one undoes the choices made by the generators.
+ *
+ * Routes are improved independently of each other, so optimizeAll() can also be run once over
+ * a finished solution as a post-optimizer.
+ */
+class SWTSReassignmentSearch : public CVLocalSearch {
+ public:
+  /**
+   * @brief Constructor with parameters
+   * @param max_iterations Maximum number of iterations
+   * @param first_improvement Whether to use first improvement
+   */
+  explicit SWTSReassignmentSearch(int max_iterations = 100, bool first_improvement = false)
+      : CVLocalSearch(max_iterations, first_improvement) {}
+
+  /**
+   * @brief Find the route whose SWTS reassignment to apply
+   */
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
+    override {
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
+
+    for (size_t route_idx = 0; route_idx < routes.size(); ++route_idx) {
+      if (!isChanged(current_solution, route_idx)) {
+        continue;
+      }
+
+      const auto placement = SWTSPlacement::optimal(routes[route_idx].zones(), problem);
+      if (!placement || placement->duration() >= routes[route_idx].totalDuration()) {
+        continue;
+      }
+
+      RouteSegment new_route = RouteSegment::routeStart(problem);
+      for (const auto location : placement->locations()) {
+        new_route =
+          RouteSegment::concat(new_route, RouteSegment::single(location, problem), problem);
+      }
+      auto move = Move::reassignSWTS(route_idx);
+      move.evaluate(problem, current_solution, new_route);
+
+      if (isImprovement(move, best_move)) {
+        best_move = move;
+
+        if (first_improvement_) {
+          return best_move;
+        }
+      }
+    }
+
+    return best_move;
+  }
+
+  /**
+   * @brief Reassign the SWTS visits of every route that gets shorter, in one pass
+   */
+  [[nodiscard]] static VRPTSolution
+    optimizeAll(const VRPTProblem& problem, VRPTSolution solution) {
+    for (size_t route_idx = 0; route_idx < solution.getCVRoutes().size(); ++route_idx) {
+      const auto& route = solution.getCVRoutes()[route_idx];
+      const auto placement = SWTSPlacement::optimal(route.zones(), problem);
+      if (placement && placement->duration() < route.totalDuration()) {
+        solution.replaceCVRoute(
+          route_idx, Move::rebuildRoute(route, placement->locations(), problem)
+        );
+      }
+    }
+    return solution;
+  }
+
+  std::string name() const override { return "SWTS Reassignment Search"; }
+};
+
+namespace {
+inline static const bool SWTSReassignmentSearch_registered_gen =
+  MetaHeuristicFactory<VRPTSolution, VRPTProblem, TypedAlgorithm<VRPTProblem, VRPTSolution>>::
+    registerSearch<SWTSReassignmentSearch>("SWTSReassignmentSearch");
+}
+
+}  // namespace algorithm
+}  // namespace daa
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "algorithm_registry.h"
 #include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
 #include "algorithms/vrpt_solution.h"
 #include "meta_heuristic_factory.h"
 #include "problem/vrpt_problem.h"
@@ -31,134 +36,77 @@ class TaskExchangeBetweenRoutesSearch : public CVLocalSearch {
       : CVLocalSearch(max_iterations, first_improvement) {}
 
   /**
-   * @brief Search the exchange neighborhood (between routes only)
+   * @brief Find the exchange move to apply (between routes only)
    */
-  VRPTSolution searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution)
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
     override {
-    VRPTSolution best_solution = current_solution;
-    size_t best_cv_count = best_solution.getCVCount();
-    int max_cv_vehicles = problem.getNumCVVehicles();
-
-    // Track current solution's metrics for comparison
-    size_t original_zones_count = current_solution.visitedZones(problem);
-    Duration best_total_duration = best_solution.totalDuration();
-
-    // Create a copy of the solution's CV routes to modify
-    auto routes = current_solution.getCVRoutes();
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
 
     // Need at least 2 routes to perform between-route exchanges
     if (routes.size() < 2) {
-      return best_solution;
+      return best_move;
     }
 
-    // Try to swap each pair of collection zones between different routes
-    for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
-      const auto& r1 = routes[r1_idx];
-      const auto& locations1 = r1.locationIds();
-
-      for (size_t pos1 = 0; pos1 < locations1.size(); ++pos1) {
-        const std::string& location_id1 = locations1[pos1];
-        const auto& location1 = problem.getLocation(location_id1);
+    // Suffix summaries of every route, so candidates are evaluated without building them
+    std::pmr::vector<std::pmr::vector<RouteSegment>> suffixes(sweep.resource());
+    suffixes.reserve(routes.size());
+    for (const auto& route : routes) {
+      suffixes.push_back(route.suffixes(problem, sweep.resource()));
+    }
 
-        // Only consider collection zones (not SWTS or depot)
-        if (location1.type() != LocationType::COLLECTION_ZONE) {
-          continue;
-        }
+    const auto& table = problem.getLocationTable();
+    const Capacity capacity = problem.getCVCapacity();
 
-        // Find another zone in a different route to swap with
-        for (size_t r2_idx = r1_idx + 1; r2_idx < routes.size(); ++r2_idx) {
-          const auto& r2 = routes[r2_idx];
-          const auto& locations2 = r2.locationIds();
+    // Try to swap each pair of collection zones between different routes, trip by trip
+    for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
+      const auto& r1 = routes[r1_idx];
+      const auto& locations1 = r1.locations();
 
-          for (size_t pos2 = 0; pos2 < locations2.size(); ++pos2) {
-            const std::string& location_id2 = locations2[pos2];
-            const auto& location2 = problem.getLocation(location_id2);
+      for (const auto& trip1 : r1.trips()) {
+        for (size_t pos1 = trip1.begin; pos1 < trip1.zonesEnd(); ++pos1) {
+          const LocationIndex location_index1 = locations1[pos1];
+          const auto zone1 = RouteSegment::single(location_index1, problem);
+          const Capacity waste1 = table.wasteAmount(location_index1);
 
-            // Only consider collection zones
-            if (location2.type() != LocationType::COLLECTION_ZONE) {
+          // Find another zone in a different route to swap with, one of them changed
+          for (size_t r2_idx = r1_idx + 1; r2_idx < routes.size(); ++r2_idx) {
+            if (!isChanged(current_solution, r1_idx) && !isChanged(current_solution, r2_idx)) {
               continue;
             }
 
-            // Create a new solution with the swap
-            VRPTSolution new_solution = current_solution;
-            auto& new_routes = new_solution.getCVRoutes();
-
-            // Create new route sequences with the swap
-            std::vector<std::string> new_r1_locations = locations1;
-            std::vector<std::string> new_r2_locations = locations2;
-
-            // Swap between different routes
-            new_r1_locations[pos1] = location_id2;
-            new_r2_locations[pos2] = location_id1;
-
-            // Rebuild the routes with the new sequences
-            Capacity cv_capacity = problem.getCVCapacity();
-            Duration cv_max_duration = problem.getCVMaxDuration();
-
-            // Create new routes
-            CVRoute new_r1(r1.vehicleId(), cv_capacity, cv_max_duration);
-            for (const auto& loc_id : new_r1_locations) {
-              if (!new_r1.canVisit(loc_id, problem)) {
-                continue;
-              }
-              new_r1.addLocation(loc_id, problem);
-            }
-
-            // Check if the first route ends at depot and has 0 load
-            if (new_r1.currentLoad().value() != 0.0 ||
-                (new_r1.lastLocationId() != problem.getDepot().id())) {
-              continue;  // Skip invalid routes
-            }
-
-            CVRoute new_r2(r2.vehicleId(), cv_capacity, cv_max_duration);
-            for (const auto& loc_id : new_r2_locations) {
-              if (!new_r2.canVisit(loc_id, problem)) {
-                continue;
-              }
-              new_r2.addLocation(loc_id, problem);
-            }
-
-            // Check if the second route ends at depot and has 0 load
-            if (new_r2.currentLoad().value() != 0.0 ||
-                (new_r2.lastLocationId() != problem.getDepot().id())) {
-              continue;  // Skip invalid routes
-            }
-
-            // Update the routes in the new solution
-            new_routes[r1_idx] = new_r1;
-            new_routes[r2_idx] = new_r2;
-
-            // Remove empty routes
-            new_routes.erase(
-              std::remove_if(
-                new_routes.begin(), new_routes.end(), [](const CVRoute& r) { return r.isEmpty(); }
-              ),
-              new_routes.end()
-            );
-
-            // Check if the new solution is better
-            size_t new_cv_count = new_routes.size();
-            size_t new_zones_count = new_solution.visitedZones(problem);
-            Duration new_total_duration = new_solution.totalDuration();
-
-            bool is_better = false;
-
-            // New solution is better if:
-            // 1. It uses fewer or equal number of vehicles (never more)
-            // 2. It visits at least the same number of zones
-            // 3. It has shorter total duration
-            if (new_cv_count <= best_cv_count && new_zones_count >= original_zones_count &&
-                new_total_duration < best_total_duration) {
-              is_better = true;
-            }
-
-            if (is_better) {
-              best_solution = new_solution;
-              best_cv_count = new_cv_count;
-              best_total_duration = new_total_duration;
-
-              if (first_improvement_) {
-                return best_solution;
+            const auto& r2 = routes[r2_idx];
+            const auto& locations2 = r2.locations();
+
+            for (const auto& trip2 : r2.trips()) {
+              for (size_t pos2 = trip2.begin; pos2 < trip2.zonesEnd(); ++pos2) {
+                const LocationIndex location_index2 = locations2[pos2];
+                const Capacity waste2 = table.wasteAmount(location_index2);
+
+                // Both trips must still fit in the vehicle after the swap
+                if (trip1.load - waste1 + waste2 > capacity ||
+                    trip2.load - waste2 + waste1 > capacity) {
+                  continue;
+                }
+
+                const auto zone2 = RouteSegment::single(location_index2, problem);
+                const auto new_r1 = RouteSegment::route(
+                  problem, r1.prefix(pos1), zone2, suffixes[r1_idx][pos1 + 1]
+                );
+                const auto new_r2 = RouteSegment::route(
+                  problem, r2.prefix(pos2), zone1, suffixes[r2_idx][pos2 + 1]
+                );
+                auto move = Move::swap(r1_idx, pos1, r2_idx, pos2);
+                move.evaluate(problem, current_solution, new_r1, new_r2);
+
+                if (isImprovement(move, best_move)) {
+                  best_move = move;
+
+                  if (first_improvement_) {
+                    return best_move;
+                  }
+                }
               }
             }
           }
@@ -166,7 +114,7 @@ class TaskExchangeBetweenRoutesSearch : public CVLocalSearch {
       }
     }
 
-    return best_solution;
+    return best_move;
   }
 
   std::string name() const override { return "Task Exchange Between Routes Search"; }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "algorithm_registry.h"
 #include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
 #include "algorithms/vrpt_solution.h"
 #include "meta_heuristic_factory.h"
 #include "problem/vrpt_problem.h"
@@ -31,110 +35,86 @@ class TaskExchangeWithinRouteSearch : public CVLocalSearch {
       : CVLocalSearch(max_iterations, first_improvement) {}
 
   /**
-   * @brief Search the exchange neighborhood (within route only)
+   * @brief Find the exchange move to apply (within route only)
    */
-  VRPTSolution searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution)
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
     override {
-    VRPTSolution best_solution = current_solution;
-    size_t best_cv_count = best_solution.getCVCount();
-    int max_cv_vehicles = problem.getNumCVVehicles();
-
-    // Track current solution's metrics for comparison
-    size_t original_zones_count = current_solution.visitedZones(problem);
-    Duration best_total_duration = best_solution.totalDuration();
-
-    // Create a copy of the solution's CV routes to modify
-    auto routes = current_solution.getCVRoutes();
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
+    const auto& table = problem.getLocationTable();
+    const Capacity capacity = problem.getCVCapacity();
 
     // Try to swap each pair of collection zones within the same route
     for (size_t r_idx = 0; r_idx < routes.size(); ++r_idx) {
       const auto& route = routes[r_idx];
-      const auto& locations = route.locationIds();
+      const auto& locations = route.locations();
 
-      // Need at least 2 locations to perform a swap
-      if (locations.size() < 2) {
+      // Need at least 2 locations to perform a swap, in a route that changed
+      if (locations.size() < 2 || !isChanged(current_solution, r_idx)) {
         continue;
       }
 
-      for (size_t pos1 = 0; pos1 < locations.size(); ++pos1) {
-        const std::string& location_id1 = locations[pos1];
-        const auto& location1 = problem.getLocation(location_id1);
-
-        // Only consider collection zones (not SWTS or depot)
-        if (location1.type() != LocationType::COLLECTION_ZONE) {
-          continue;
-        }
-
-        // Find another zone in the same route to swap with
-        for (size_t pos2 = pos1 + 1; pos2 < locations.size(); ++pos2) {
-          const std::string& location_id2 = locations[pos2];
-          const auto& location2 = problem.getLocation(location_id2);
+      const auto suffixes = route.suffixes(problem, sweep.resource());
+      const auto& trips = route.trips();
 
-          // Only consider collection zones
-          if (location2.type() != LocationType::COLLECTION_ZONE) {
-            continue;
-          }
+      for (size_t t1 = 0; t1 < trips.size(); ++t1) {
+        const auto& trip1 = trips[t1];
 
-          // Create a new solution with the swap
-          VRPTSolution new_solution = current_solution;
-          auto& new_routes = new_solution.getCVRoutes();
+        for (size_t pos1 = trip1.begin; pos1 < trip1.zonesEnd(); ++pos1) {
+          const LocationIndex location_index1 = locations[pos1];
+          const auto zone1 = RouteSegment::single(location_index1, problem);
+          const Capacity waste1 = table.wasteAmount(location_index1);
 
-          // Create new route sequence with the swap
-          std::vector<std::string> new_locations = locations;
-          std::swap(new_locations[pos1], new_locations[pos2]);
+          // Locations strictly between the two swapped zones
+          RouteSegment middle;
 
-          // Rebuild the route with the new sequence
-          Capacity cv_capacity = problem.getCVCapacity();
-          Duration cv_max_duration = problem.getCVMaxDuration();
+          // Find another zone in the same route to swap with, tracking its trip t2
+          size_t t2 = t1;
+          for (size_t pos2 = pos1 + 1; pos2 < locations.size(); ++pos2) {
+            if (pos2 > pos1 + 1) {
+              const auto location = RouteSegment::single(locations[pos2 - 1], problem);
+              middle = RouteSegment::concat(middle, location, problem);
+            }
+            if (pos2 == trips[t2].end) {
+              ++t2;
+            }
 
-          // Create new route
-          CVRoute new_route(route.vehicleId(), cv_capacity, cv_max_duration);
-          for (const auto& loc_id : new_locations) {
-            if (!new_route.canVisit(loc_id, problem)) {
+            // Skip the stop closing the trip
+            const auto& trip2 = trips[t2];
+            if (pos2 >= trip2.zonesEnd()) {
               continue;
             }
-            new_route.addLocation(loc_id, problem);
-          }
-
-          // Check if the route ends at depot and has 0 load
-          if (new_route.currentLoad().value() != 0.0 ||
-              (new_route.lastLocationId() != problem.getDepot().id())) {
-            continue;  // Skip invalid routes
-          }
-
-          // Update the route in the new solution
-          new_routes[r_idx] = new_route;
 
-          // Check if the new solution is better
-          size_t new_cv_count = new_routes.size();
-          size_t new_zones_count = new_solution.visitedZones(problem);
-          Duration new_total_duration = new_solution.totalDuration();
+            const LocationIndex location_index2 = locations[pos2];
+            const Capacity waste2 = table.wasteAmount(location_index2);
 
-          bool is_better = false;
+            // Swapping zones of different trips moves waste between them
+            if (t2 != t1 && (trip1.load - waste1 + waste2 > capacity ||
+                             trip2.load - waste2 + waste1 > capacity)) {
+              continue;
+            }
 
-          // New solution is better if:
-          // 1. It uses fewer or equal number of vehicles (never more)
-          // 2. It visits at least the same number of zones
-          // 3. It has shorter total duration
-          if (new_cv_count <= best_cv_count && new_zones_count >= original_zones_count &&
-              new_total_duration < best_total_duration) {
-            is_better = true;
-          }
+            const auto zone2 = RouteSegment::single(location_index2, problem);
+            const auto new_route = RouteSegment::route(
+              problem, route.prefix(pos1), zone2, middle, zone1, suffixes[pos2 + 1]
+            );
+            auto move = Move::swap(r_idx, pos1, r_idx, pos2);
+            move.evaluate(problem, current_solution, new_route);
 
-          if (is_better) {
-            best_solution = new_solution;
-            best_cv_count = new_cv_count;
-            best_total_duration = new_total_duration;
+            if (isImprovement(move, best_move)) {
+              best_move = move;
 
-            if (first_improvement_) {
-              return best_solution;
+              if (first_improvement_) {
+                return best_move;
+              }
             }
           }
         }
       }
     }
 
-    return best_solution;
+    return best_move;
   }
 
   std::string name() const override { return "Task Exchange Within Route Search"; }
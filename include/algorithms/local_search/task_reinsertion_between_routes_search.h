@@ -1,24 +1,51 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "algorithm_registry.h"
 #include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
 #include "algorithms/vrpt_solution.h"
+#include "imgui.h"
 #include "meta_heuristic_factory.h"
+#include "problem/neighbor_lists.h"
 #include "problem/vrpt_problem.h"
 
 namespace daa {
 namespace algorithm {
 
+/**
+ * @brief Candidate restriction of the granular TaskReinsertionBetweenRoutesSearch
+ */
+struct GranularReinsertionOptions {
+  bool enabled{false};
+  size_t neighbor_count{8};  // Nearest zones to insert next to
+  // Neighbors farther than this multiple of the mean neighbor distance are skipped, except the
+  // nearest one; 0 keeps them all
+  double threshold{1.5};
+};
+
 /**
  * @brief Task Reinsertion Between Routes local search for CV routes
  *
  * Tries to move a collection zone from its current position in one route
  * to a position in a different route. This is a specialized version of 
  * TaskReinsertionSearch that only considers moves between different routes.
+ *
+ * The full scan tries every position of every other route. In granular mode a zone is only
+ * inserted right before or after one of its nearest zones (Toth and Vigo's granular
+ * neighborhoods): O(n * k) candidates per sweep instead of O(n^2). The neighbors come from the
+ * problem's zone neighbor lists, or from longer lists the search builds once per problem when
+ * it asks for more neighbors than those hold.
  */
 class TaskReinsertionBetweenRoutesSearch : public CVLocalSearch {
  public:
@@ -28,150 +55,297 @@ class TaskReinsertionBetweenRoutesSearch : public CVLocalSearch {
    * @param first_improvement Whether to use first improvement
    */
   explicit TaskReinsertionBetweenRoutesSearch(int max_iterations = 100, bool first_improvement = false)
-      : CVLocalSearch(max_iterations, first_improvement) {}
+      : CVLocalSearch(max_iterations, first_improvement),
+        granular_(defaultGranularOptions()) {}
 
   /**
-   * @brief Search the reinsertion neighborhood (between routes only)
+   * @brief Options new searches start with
+   *
+   * Metaheuristic workers create their own searches by name, so the CLI and the configuration
+   * UI set the options through these defaults.
    */
-  VRPTSolution searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution)
-    override {
-    VRPTSolution best_solution = current_solution;
-    size_t best_cv_count = best_solution.getCVCount();
-    int max_cv_vehicles = problem.getNumCVVehicles();
+  [[nodiscard]] static GranularReinsertionOptions defaultGranularOptions() {
+    std::scoped_lock lock(defaults_mutex_);
+    return default_granular_;
+  }
 
-    // Track current solution's metrics for comparison
-    size_t original_zones_count = current_solution.visitedZones(problem);
-    Duration best_total_duration = best_solution.totalDuration();
+  static void setDefaultGranularOptions(const GranularReinsertionOptions& options) {
+    std::scoped_lock lock(defaults_mutex_);
+    default_granular_ = options;
+  }
 
-    // Create a copy of the solution's CV routes to modify
-    auto routes = current_solution.getCVRoutes();
+  [[nodiscard]] const GranularReinsertionOptions& granularOptions() const noexcept {
+    return granular_;
+  }
+  void setGranularOptions(const GranularReinsertionOptions& options) { granular_ = options; }
+
+  /**
+   * @brief Find the reinsertion move to apply (between routes only)
+   */
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
+    override {
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
 
     // Need at least 2 routes to perform between-route reinsertions
     if (routes.size() < 2) {
-      return best_solution;
+      return best_move;
+    }
+
+    // Suffix summaries of every route, so candidates are evaluated without building them
+    std::pmr::vector<std::pmr::vector<RouteSegment>> suffixes(sweep.resource());
+    suffixes.reserve(routes.size());
+    for (const auto& route : routes) {
+      suffixes.push_back(route.suffixes(problem, sweep.resource()));
+    }
+
+    if (granular_.enabled) {
+      return findGranularMove(problem, current_solution, suffixes, sweep.resource());
     }
 
     // Try to move each collection zone to a different route
     for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
       const auto& r1 = routes[r1_idx];
-      const auto& locations1 = r1.locationIds();
-
-      // Check each location in the route
-      for (size_t pos1 = 0; pos1 < locations1.size(); ++pos1) {
-        const std::string& location_id = locations1[pos1];
-        const auto& location = problem.getLocation(location_id);
+      const auto& locations1 = r1.locations();
+
+      // Check each zone of the route, trip by trip
+      for (const auto& trip1 : r1.trips()) {
+        for (size_t pos1 = trip1.begin; pos1 < trip1.zonesEnd(); ++pos1) {
+          const LocationIndex location_index = locations1[pos1];
+
+          // The first route without the zone does not depend on where it goes
+          const auto new_r1 =
+            RouteSegment::route(problem, r1.prefix(pos1), suffixes[r1_idx][pos1 + 1]);
+          if (!new_r1.isFeasibleRoute(problem)) {
+            continue;  // Skip invalid routes
+          }
+          const auto zone = RouteSegment::single(location_index, problem);
+          const Capacity waste = problem.getLocationTable().wasteAmount(location_index);
+
+          // Try to move this zone to every possible position in every other route
+          for (size_t r2_idx = 0; r2_idx < routes.size(); ++r2_idx) {
+            // Skip if it's the same route, or neither route changed
+            if (r1_idx == r2_idx ||
+                (!isChanged(current_solution, r1_idx) && !isChanged(current_solution, r2_idx))) {
+              continue;
+            }
 
-        // Only consider collection zones (not SWTS or depot)
-        if (location.type() != LocationType::COLLECTION_ZONE) {
-          continue;
-        }
+            const auto& r2 = routes[r2_idx];
 
-        // Try to move this zone to every possible position in every other route
-        for (size_t r2_idx = 0; r2_idx < routes.size(); ++r2_idx) {
-          // Skip if it's the same route
-          if (r1_idx == r2_idx) {
-            continue;
-          }
+            // The zone joins the trip holding the position it is inserted before, so trips
+            // without room for it are skipped whole. Inserting after the last location would
+            // leave the route away from the depot.
+            for (const auto& trip2 : r2.trips()) {
+              if (trip2.load + waste > problem.getCVCapacity()) {
+                continue;
+              }
 
-          const auto& r2 = routes[r2_idx];
-          const auto& locations2 = r2.locationIds();
+              for (size_t pos2 = trip2.begin; pos2 < trip2.end; ++pos2) {
+                const auto new_r2 =
+                  RouteSegment::route(problem, r2.prefix(pos2), zone, suffixes[r2_idx][pos2]);
+                auto move = Move::relocate(r1_idx, pos1, r2_idx, pos2);
+                move.evaluate(problem, current_solution, new_r1, new_r2);
 
-          // Try each possible insertion position in the target route
-          for (size_t pos2 = 0; pos2 <= locations2.size(); ++pos2) {
-            // Create a new solution with the move
-            VRPTSolution new_solution = current_solution;
-            auto& new_routes = new_solution.getCVRoutes();
+                if (isImprovement(move, best_move)) {
+                  best_move = move;
 
-            // Remove the zone from its original route
-            std::vector<std::string> new_r1_locations;
-            for (size_t i = 0; i < locations1.size(); ++i) {
-              if (i != pos1) {
-                new_r1_locations.push_back(locations1[i]);
+                  if (first_improvement_) {
+                    return best_move;
+                  }
+                }
               }
             }
+          }
+        }
+      }
+    }
 
-            // Insert the zone into the target route
-            std::vector<std::string> new_r2_locations;
-            for (size_t i = 0; i < locations2.size(); ++i) {
-              if (i == pos2) {
-                new_r2_locations.push_back(location_id);
-              }
-              new_r2_locations.push_back(locations2[i]);
-            }
+    return best_move;
+  }
 
-            // Handle insertion at the end
-            if (pos2 == locations2.size()) {
-              new_r2_locations.push_back(location_id);
-            }
+  std::string name() const override { return "Task Reinsertion Between Routes Search"; }
 
-            // Rebuild the routes with the new location sequences
-            Capacity cv_capacity = problem.getCVCapacity();
-            Duration cv_max_duration = problem.getCVMaxDuration();
+  void renderConfigurationUI() override {
+    CVLocalSearch::renderConfigurationUI();
 
-            // Create new routes
-            CVRoute new_r1(r1.vehicleId(), cv_capacity, cv_max_duration);
-            for (const auto& loc_id : new_r1_locations) {
-              if (!new_r1.canVisit(loc_id, problem)) {
-                continue;
-              }
-              new_r1.addLocation(loc_id, problem);
-            }
+    bool changed = ImGui::Checkbox("Granular", &granular_.enabled);
+    ImGui::SameLine();
+    ImGui::HelpMarker("Only insert zones next to one of their nearest zones");
 
-            // Check if the first route ends at depot and has 0 load
-            if (!new_r1_locations.empty() && (new_r1.currentLoad().value() != 0.0 ||
-                                              new_r1.lastLocationId() != problem.getDepot().id())) {
-              continue;  // Skip invalid routes
-            }
+    if (granular_.enabled) {
+      int neighbor_count = static_cast<int>(granular_.neighbor_count);
+      if (ImGui::SliderInt("Neighbors", &neighbor_count, 1, 32)) {
+        granular_.neighbor_count = static_cast<size_t>(neighbor_count);
+        changed = true;
+      }
 
-            CVRoute new_r2(r2.vehicleId(), cv_capacity, cv_max_duration);
-            for (const auto& loc_id : new_r2_locations) {
-              if (!new_r2.canVisit(loc_id, problem)) {
-                continue;
-              }
-              new_r2.addLocation(loc_id, problem);
+      float threshold = static_cast<float>(granular_.threshold);
+      if (ImGui::SliderFloat("Threshold", &threshold, 0.0f, 5.0f, "%.2f")) {
+        granular_.threshold = static_cast<double>(threshold);
+        changed = true;
+      }
+      ImGui::SameLine();
+      ImGui::HelpMarker("Skip neighbors farther than this multiple of the mean neighbor distance");
+    }
+
+    if (changed) {
+      setDefaultGranularOptions(granular_);
+    }
+  }
+
+ private:
+  inline static std::mutex defaults_mutex_;
+  inline static GranularReinsertionOptions default_granular_{};
+
+  GranularReinsertionOptions granular_;
+
+  // Zone neighbor lists longer than the problem's, and the problem generation and neighbor count
+  // they were built for
+  NeighborLists long_neighbors_;
+  std::uint64_t long_neighbors_generation_{0};
+  size_t long_neighbors_count_{0};
+
+  // Granular distance limit, and the problem generation, neighbor count and threshold it was
+  // computed for
+  double granular_limit_{0.0};
+  std::uint64_t granular_limit_generation_{0};
+  size_t granular_limit_count_{0};
+  double granular_limit_threshold_{0.0};
+
+  /**
+   * @brief Zone neighbor lists holding at least the configured number of neighbors per zone
+   */
+  [[nodiscard]] const NeighborLists& zoneNeighbors(const VRPTProblem& problem) {
+    if (granular_.neighbor_count <= problem.getZoneNeighborCount()) {
+      return problem.getZoneNeighbors();
+    }
+    if (long_neighbors_generation_ != problem.getGeneration() ||
+        long_neighbors_count_ != granular_.neighbor_count) {
+      long_neighbors_ =
+        problem.findKNearestAll(LocationType::COLLECTION_ZONE, granular_.neighbor_count);
+      long_neighbors_generation_ = problem.getGeneration();
+      long_neighbors_count_ = granular_.neighbor_count;
+    }
+    return long_neighbors_;
+  }
+
+  /**
+   * @brief Distance beyond which granular mode skips a neighbor
+   *
+   * The mean neighbor distance takes a pass over every zone, so it is computed once per problem
+   * and options instead of on every sweep.
+   */
+  [[nodiscard]] double granularLimit(const VRPTProblem& problem, const NeighborLists& neighbors) {
+    if (granular_.threshold <= 0.0) {
+      return std::numeric_limits<double>::infinity();
+    }
+    if (granular_limit_generation_ == problem.getGeneration() &&
+        granular_limit_count_ == granular_.neighbor_count &&
+        granular_limit_threshold_ == granular_.threshold) {
+      return granular_limit_;
+    }
+
+    double total = 0.0;
+    size_t count = 0;
+    for (const auto zone : problem.getZones()) {
+      const auto distances = neighbors.distances(zone);
+      for (size_t c = 0; c < std::min(granular_.neighbor_count, distances.size()); ++c) {
+        total += distances[c];
+        ++count;
+      }
+    }
+    granular_limit_ = count > 0 ? granular_.threshold * total / static_cast<double>(count)
+                                : std::numeric_limits<double>::infinity();
+    granular_limit_generation_ = problem.getGeneration();
+    granular_limit_count_ = granular_.neighbor_count;
+    granular_limit_threshold_ = granular_.threshold;
+    return granular_limit_;
+  }
+
+  /**
+   * @brief Find the move to apply, inserting zones only next to their nearest zones
+   *
+   * Both positions adjacent to a neighbor join its trip, so the trip load prunes them together.
+   */
+  std::optional<Move> findGranularMove(
+    const VRPTProblem& problem,
+    const VRPTSolution& current_solution,
+    const std::pmr::vector<std::pmr::vector<RouteSegment>>& suffixes,
+    std::pmr::memory_resource* resource
+  ) {
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
+
+    // Where each zone is visited; zones left unvisited keep routes.size() as their route
+    struct Slot {
+      size_t route;
+      size_t position;
+      size_t trip;
+    };
+    std::pmr::vector<Slot> slots(problem.getLocationCount(), Slot{routes.size(), 0, 0}, resource);
+    for (size_t r = 0; r < routes.size(); ++r) {
+      const auto& trips = routes[r].trips();
+      for (size_t t = 0; t < trips.size(); ++t) {
+        for (size_t pos = trips[t].begin; pos < trips[t].zonesEnd(); ++pos) {
+          slots[routes[r].locations()[pos]] = {r, pos, t};
+        }
+      }
+    }
+
+    const auto& neighbors = zoneNeighbors(problem);
+    const double limit = granularLimit(problem, neighbors);
+
+    for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
+      const auto& r1 = routes[r1_idx];
+
+      for (const auto& trip1 : r1.trips()) {
+        for (size_t pos1 = trip1.begin; pos1 < trip1.zonesEnd(); ++pos1) {
+          const LocationIndex location_index = r1.locations()[pos1];
+
+          const auto new_r1 =
+            RouteSegment::route(problem, r1.prefix(pos1), suffixes[r1_idx][pos1 + 1]);
+          if (!new_r1.isFeasibleRoute(problem)) {
+            continue;
+          }
+          const auto zone = RouteSegment::single(location_index, problem);
+          const Capacity waste = problem.getLocationTable().wasteAmount(location_index);
+
+          const auto candidates = neighbors.neighbors(location_index);
+          const auto distances = neighbors.distances(location_index);
+          const size_t count = std::min(granular_.neighbor_count, candidates.size());
+
+          for (size_t c = 0; c < count; ++c) {
+            // Neighbors come closest first, so the rest are beyond the limit too
+            if (c > 0 && distances[c] > limit) {
+              break;
             }
 
-            // Check if the second route ends at depot and has 0 load
-            if (!new_r2_locations.empty() && (new_r2.currentLoad().value() != 0.0 ||
-                                              new_r2.lastLocationId() != problem.getDepot().id())) {
-              continue;  // Skip invalid routes
+            const Slot& slot = slots[candidates[c]];
+            if (slot.route == routes.size() || slot.route == r1_idx ||
+                (!isChanged(current_solution, r1_idx) &&
+                 !isChanged(current_solution, slot.route))) {
+              continue;
             }
 
-            // Update the routes in the new solution
-            new_routes[r1_idx] = new_r1;
-            new_routes[r2_idx] = new_r2;
-
-            // Remove empty routes
-            new_routes.erase(
-              std::remove_if(
-                new_routes.begin(), new_routes.end(), [](const CVRoute& r) { return r.isEmpty(); }
-              ),
-              new_routes.end()
-            );
-
-            // Check if the new solution is better
-            size_t new_cv_count = new_routes.size();
-            size_t new_zones_count = new_solution.visitedZones(problem);
-            Duration new_total_duration = new_solution.totalDuration();
-
-            bool is_better = false;
-
-            // New solution is better if:
-            // 1. It uses fewer or equal number of vehicles (never more)
-            // 2. It visits at least the same number of zones
-            // 3. It has shorter total duration
-            if (new_cv_count <= best_cv_count && new_zones_count >= original_zones_count &&
-                new_total_duration < best_total_duration) {
-              is_better = true;
+            const auto& r2 = routes[slot.route];
+            if (r2.trips()[slot.trip].load + waste > problem.getCVCapacity()) {
+              continue;
             }
 
-            if (is_better) {
-              best_solution = new_solution;
-              best_cv_count = new_cv_count;
-              best_total_duration = new_total_duration;
+            // Right before the neighbor, then right after it
+            for (const size_t pos2 : {slot.position, slot.position + 1}) {
+              const auto new_r2 =
+                RouteSegment::route(problem, r2.prefix(pos2), zone, suffixes[slot.route][pos2]);
+              auto move = Move::relocate(r1_idx, pos1, slot.route, pos2);
+              move.evaluate(problem, current_solution, new_r1, new_r2);
+
+              if (isImprovement(move, best_move)) {
+                best_move = move;
 
-              if (first_improvement_) {
-                return best_solution;
+                if (first_improvement_) {
+                  return best_move;
+                }
               }
             }
           }
@@ -179,10 +353,8 @@ class TaskReinsertionBetweenRoutesSearch : public CVLocalSearch {
       }
     }
 
-    return best_solution;
+    return best_move;
   }
-
-  std::string name() const override { return "Task Reinsertion Between Routes Search"; }
 };
 
 namespace {
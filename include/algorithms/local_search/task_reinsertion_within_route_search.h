@@ -1,11 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "algorithm_registry.h"
 #include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
 #include "algorithms/vrpt_solution.h"
 #include "meta_heuristic_factory.h"
 #include "problem/vrpt_problem.h"
@@ -31,117 +36,92 @@ class TaskReinsertionWithinRouteSearch : public CVLocalSearch {
       : CVLocalSearch(max_iterations, first_improvement) {}
 
   /**
-   * @brief Search the reinsertion neighborhood (within route only)
+   * @brief Find the reinsertion move to apply (within route only)
    */
-  VRPTSolution searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution)
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
     override {
-    VRPTSolution best_solution = current_solution;
-    size_t best_cv_count = best_solution.getCVCount();
-    int max_cv_vehicles = problem.getNumCVVehicles();
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
 
-    // Track current solution's metrics for comparison
-    size_t original_zones_count = current_solution.visitedZones(problem);
-    Duration best_total_duration = best_solution.totalDuration();
-
-    // Create a copy of the solution's CV routes to modify
-    auto routes = current_solution.getCVRoutes();
+    // Summaries of the locations from each position up to the moved zone, reused per zone
+    std::pmr::vector<RouteSegment> before(sweep.resource());
 
     // Try to move each collection zone to a different position within the same route
     for (size_t r_idx = 0; r_idx < routes.size(); ++r_idx) {
       const auto& route = routes[r_idx];
-      const auto& locations = route.locationIds();
+      const auto& locations = route.locations();
 
-      // Need at least 2 locations to perform a reinsertion
-      if (locations.size() < 2) {
+      // Need at least 2 locations to perform a reinsertion, in a route that changed
+      if (locations.size() < 2 || !isChanged(current_solution, r_idx)) {
         continue;
       }
 
-      // Check each location in the route
-      for (size_t pos1 = 0; pos1 < locations.size(); ++pos1) {
-        const std::string& location_id = locations[pos1];
-        const auto& location = problem.getLocation(location_id);
-
-        // Only consider collection zones (not SWTS or depot)
-        if (location.type() != LocationType::COLLECTION_ZONE) {
-          continue;
-        }
-
-        // Try each possible insertion position in the same route
-        for (size_t pos2 = 0; pos2 <= locations.size(); ++pos2) {
-          // Skip if trying to insert at the same position or adjacent position
-          if (pos2 == pos1 || pos2 == pos1 + 1) {
-            continue;
+      const auto suffixes = route.suffixes(problem, sweep.resource());
+      const auto& trips = route.trips();
+
+      // Check each zone of the route, trip by trip
+      for (size_t t1 = 0; t1 < trips.size(); ++t1) {
+        for (size_t pos1 = trips[t1].begin; pos1 < trips[t1].zonesEnd(); ++pos1) {
+          const LocationIndex location_index = locations[pos1];
+          const auto zone = RouteSegment::single(location_index, problem);
+          const Capacity waste = problem.getLocationTable().wasteAmount(location_index);
+
+          // before[k] covers positions [k, pos1)
+          before.assign(pos1 + 1, RouteSegment{});
+          for (size_t k = pos1; k-- > 0;) {
+            const auto location = RouteSegment::single(locations[k], problem);
+            before[k] = RouteSegment::concat(location, before[k + 1], problem);
           }
 
-          // Create a new solution with the move
-          VRPTSolution new_solution = current_solution;
-          auto& new_routes = new_solution.getCVRoutes();
-
-          // Create new route sequence with the reinsertion
-          std::vector<std::string> new_locations;
-          
-          // First, add all locations except the one being moved
-          for (size_t i = 0; i < locations.size(); ++i) {
-            if (i != pos1) {
-              new_locations.push_back(locations[i]);
+          // Locations between the zone and the insertion point when moving it forward
+          RouteSegment after;
+
+          // Try each possible insertion position in the same route. The zone joins trip t2,
+          // the one holding the position it is inserted before; inserting after the last
+          // location would leave the route away from the depot.
+          size_t t2 = 0;
+          for (size_t pos2 = 0; pos2 < locations.size(); ++pos2) {
+            if (pos2 > pos1 + 1) {
+              const auto location = RouteSegment::single(locations[pos2 - 1], problem);
+              after = RouteSegment::concat(after, location, problem);
             }
-          }
-          
-          // Then, insert the location at the new position
-          new_locations.insert(new_locations.begin() + (pos2 > pos1 ? pos2 - 1 : pos2), location_id);
-
-          // Rebuild the route with the new sequence
-          Capacity cv_capacity = problem.getCVCapacity();
-          Duration cv_max_duration = problem.getCVMaxDuration();
-
-          // Create new route
-          CVRoute new_route(route.vehicleId(), cv_capacity, cv_max_duration);
-          for (const auto& loc_id : new_locations) {
-            if (!new_route.canVisit(loc_id, problem)) {
-              continue;
+            if (pos2 == trips[t2].end) {
+              ++t2;
             }
-            new_route.addLocation(loc_id, problem);
-          }
-
-          // Check if the route ends at depot and has 0 load
-          if (new_route.currentLoad().value() != 0.0 ||
-              (new_route.lastLocationId() != problem.getDepot().id())) {
-            continue;  // Skip invalid routes
-          }
 
-          // Update the route in the new solution
-          new_routes[r_idx] = new_route;
-
-          // Check if the new solution is better
-          size_t new_cv_count = new_routes.size();
-          size_t new_zones_count = new_solution.visitedZones(problem);
-          Duration new_total_duration = new_solution.totalDuration();
-
-          bool is_better = false;
-
-          // New solution is better if:
-          // 1. It uses fewer or equal number of vehicles (never more)
-          // 2. It visits at least the same number of zones
-          // 3. It has shorter total duration
-          if (new_cv_count <= best_cv_count && new_zones_count >= original_zones_count &&
-              new_total_duration < best_total_duration) {
-            is_better = true;
-          }
+            // Skip if trying to insert at the same position or adjacent position
+            if (pos2 == pos1 || pos2 == pos1 + 1) {
+              continue;
+            }
 
-          if (is_better) {
-            best_solution = new_solution;
-            best_cv_count = new_cv_count;
-            best_total_duration = new_total_duration;
+            // Another trip must have room for the zone
+            if (t2 != t1 && trips[t2].load + waste > problem.getCVCapacity()) {
+              continue;
+            }
 
-            if (first_improvement_) {
-              return best_solution;
+            const auto new_route =
+              pos2 < pos1
+                ? RouteSegment::route(
+                    problem, route.prefix(pos2), zone, before[pos2], suffixes[pos1 + 1]
+                  )
+                : RouteSegment::route(problem, route.prefix(pos1), after, zone, suffixes[pos2]);
+            auto move = Move::relocate(r_idx, pos1, r_idx, pos2);
+            move.evaluate(problem, current_solution, new_route);
+
+            if (isImprovement(move, best_move)) {
+              best_move = move;
+
+              if (first_improvement_) {
+                return best_move;
+              }
             }
           }
         }
       }
     }
 
-    return best_solution;
+    return best_move;
   }
 
   std::string name() const override { return "Task Reinsertion Within Route Search"; }
@@ -2,12 +2,16 @@
 
 #include <algorithm>
 #include <concepts>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <vector>
 
 #include "algorithm_registry.h"
 #include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
 #include "algorithms/vrpt_solution.h"
 #include "meta_heuristic_factory.h"
 #include "problem/vrpt_problem.h"
@@ -32,83 +36,55 @@ class TwoOptSearch : public CVLocalSearch {
       : CVLocalSearch(max_iterations, first_improvement) {}
 
   /**
-   * @brief Search the 2-opt neighborhood
+   * @brief Find the 2-opt move to apply
+   *
+   * With first improvement, the search still finishes the route in which it found the first
+   * improving move and returns the best move of that route.
    */
-  VRPTSolution searchNeighborhood(const VRPTProblem& problem, const VRPTSolution& current_solution)
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
     override {
-    VRPTSolution best_solution = current_solution;
-    size_t original_cv_count = current_solution.getCVCount();
-
-    // Calculate total duration of the current best solution
-    Duration best_total_duration = best_solution.totalDuration();
-
-    // Count zones visited in the initial solution
-    size_t original_zones_count = best_solution.visitedZones(problem);
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
 
     // Apply 2-opt to each route
     for (size_t route_idx = 0; route_idx < current_solution.getCVRoutes().size(); ++route_idx) {
       const auto& route = current_solution.getCVRoutes()[route_idx];
-      const auto& locations = route.locationIds();
+      const auto& locations = route.locations();
 
-      // Need at least 4 locations for 2-opt to make sense
-      if (locations.size() < 4)
+      // Need at least 4 locations for 2-opt to make sense, in a route that changed
+      if (locations.size() < 4 || !isChanged(current_solution, route_idx))
         continue;
 
-      // Use the helper function to iterate through all valid 2-opt swap pairs
-      forEach2OptPair(locations.size(), [&](size_t i, size_t j) {
-        // Create a new solution with the 2-opt swap
-        VRPTSolution new_solution = current_solution;
-        auto& new_routes = new_solution.getCVRoutes();
-
-        // Create the new sequence with the reversed segment using std::reverse
-        std::vector<std::string> new_locations(locations);
-        std::reverse(new_locations.begin() + i + 1, new_locations.begin() + j + 1);
+      const auto suffixes = route.suffixes(problem, sweep.resource());
 
-        // Rebuild the route with the new sequence
-        CVRoute new_route(route.vehicleId(), problem.getCVCapacity(), problem.getCVMaxDuration());
+      // Summary of locations i + 1 .. j in reverse order, grown by one location per j
+      RouteSegment reversed;
 
-        for (const auto& loc_id : new_locations) {
-          if (new_route.canVisit(loc_id, problem)) {
-            new_route.addLocation(loc_id, problem);
-          }
-        }
-
-        // Only proceed if the new route is valid:
-        // 1. Final load must be 0 (all waste delivered)
-        // 2. Route must end at depot
-        if (new_route.currentLoad().value() != 0.0 ||
-            (new_route.lastLocationId() != problem.getDepot().id())) {
-          return;  // Skip invalid routes
+      // Use the helper function to iterate through all valid 2-opt swap pairs
+      forEach2OptPair(locations.size(), [&](size_t i, size_t j) {
+        if (j == i + 2) {
+          reversed = RouteSegment::single(locations[i + 1], problem);
         }
+        reversed =
+          RouteSegment::concat(RouteSegment::single(locations[j], problem), reversed, problem);
 
-        // Update the route
-        new_routes[route_idx] = new_route;
-
-        // Check if the new solution is better
-        size_t new_cv_count = new_solution.getCVCount();
-        Duration new_total_duration = new_solution.totalDuration();
-        size_t new_zones_count = new_solution.visitedZones(problem);
-
-        // Check if solution is better (with simplified evaluation logic)
-        if (new_cv_count <= original_cv_count && new_zones_count >= original_zones_count &&
-            new_total_duration < best_total_duration) {
-          best_solution = new_solution;
-          best_total_duration = new_total_duration;
-          original_zones_count = new_zones_count;
+        const auto new_route =
+          RouteSegment::route(problem, route.prefix(i + 1), reversed, suffixes[j + 1]);
+        auto move = Move::twoOpt(route_idx, i, j);
+        move.evaluate(problem, current_solution, new_route);
 
-          if (first_improvement_) {
-            return;  // Early return from lambda to exit the search
-          }
+        if (isImprovement(move, best_move)) {
+          best_move = move;
         }
       });
 
-      // If first_improvement_ and we found an improvement, the lambda would have returned
-      if (first_improvement_ && best_solution != current_solution) {
+      // If first_improvement_ and we found an improvement, stop after this route
+      if (first_improvement_ && best_move) {
         break;
       }
     }
 
-    return best_solution;
+    return best_move;
   }
 
   std::string name() const override { return "2-Opt Search"; }
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "algorithm_registry.h"
+#include "algorithms/local_search/cv_local_search.h"
+#include "algorithms/local_search/move.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/route_segment.h"
+#include "algorithms/vrpt_solution.h"
+#include "meta_heuristic_factory.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @brief 2-opt* local search for CV routes
+ *
+ * Cuts two routes inside one trip each and exchanges everything after the cuts, which untangles
+ * routes that cross each other. The two cut trips are joined across the routes, each finishing
+ * at the SWTS of the other route's trip, and the later trips move with their tails unchanged.
+ * This is the cross exchange whose runs reach the end of both routes. Candidates are evaluated
+ * by joining a prefix and a suffix RouteSegment, in O(1), and a route left without zones is
+ * emptied, so two routes can also be merged into one.
+ */
+class TwoOptStarSearch : public CVLocalSearch {
+ public:
+  /**
+   * @brief Constructor with parameters
+   * @param max_iterations Maximum number of iterations
+   * @param first_improvement Whether to use first improvement
+   */
+  explicit TwoOptStarSearch(int max_iterations = 100, bool first_improvement = false)
+      : CVLocalSearch(max_iterations, first_improvement) {}
+
+  /**
+   * @brief Find the tail exchange to apply
+   */
+  std::optional<Move> findMove(const VRPTProblem& problem, const VRPTSolution& current_solution)
+    override {
+    SearchArena::Scope sweep;
+    std::optional<Move> best_move;
+    const auto& routes = current_solution.getCVRoutes();
+    const Capacity capacity = problem.getCVCapacity();
+
+    if (routes.size() < 2) {
+      return best_move;
+    }
+
+    std::pmr::vector<std::pmr::vector<RouteSegment>> suffixes(sweep.resource());
+    std::pmr::vector<std::pmr::vector<Cut>> cuts(sweep.resource());
+    suffixes.reserve(routes.size());
+    cuts.reserve(routes.size());
+    for (const auto& route : routes) {
+      suffixes.push_back(route.suffixes(problem, sweep.resource()));
+      cuts.push_back(routeCuts(route, problem, sweep.resource()));
+    }
+
+    for (size_t r1_idx = 0; r1_idx < routes.size(); ++r1_idx) {
+      const auto& r1 = routes[r1_idx];
+      const size_t size1 = r1.locations().size();
+      const size_t zones1 = r1.zones().size();
+
+      for (size_t r2_idx = r1_idx + 1; r2_idx < routes.size(); ++r2_idx) {
+        if (!isChanged(current_solution, r1_idx) && !isChanged(current_solution, r2_idx)) {
+          continue;
+        }
+
+        const auto& r2 = routes[r2_idx];
+        const size_t size2 = r2.locations().size();
+        const size_t zones2 = r2.zones().size();
+
+        for (const auto& cut1 : cuts[r1_idx]) {
+          for (const auto& cut2 : cuts[r2_idx]) {
+            // Exchanging whole routes changes nothing
+            if (cut1.pos == 0 && cut2.pos == 0) {
+              continue;
+            }
+
+            // Each joined trip carries the head of one cut trip and the tail of the other
+            if (cut1.head_load + cut2.tail_load > capacity ||
+                cut2.head_load + cut1.tail_load > capacity) {
+              continue;
+            }
+
+            const auto new_r1 =
+              cut1.zones_before + zones2 - cut2.zones_before == 0
+                ? RouteSegment{}
+                : RouteSegment::route(problem, r1.prefix(cut1.pos), suffixes[r2_idx][cut2.pos]);
+            const auto new_r2 =
+              cut2.zones_before + zones1 - cut1.zones_before == 0
+                ? RouteSegment{}
+                : RouteSegment::route(problem, r2.prefix(cut2.pos), suffixes[r1_idx][cut1.pos]);
+            auto move = Move::crossExchange(
+              r1_idx, cut1.pos, size1 - cut1.pos, r2_idx, cut2.pos, size2 - cut2.pos
+            );
+            move.evaluate(problem, current_solution, new_r1, new_r2);
+
+            if (isImprovement(move, best_move)) {
+              best_move = move;
+
+              if (first_improvement_) {
+                return best_move;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return best_move;
+  }
+
+  std::string name() const override { return "2-Opt* Search"; }
+
+ private:
+  // A place to cut a route: before position `pos`, inside the zones of a trip
+  struct Cut {
+    size_t pos{0};
+    size_t zones_before{0};   // Zones of the route before the cut
+    Capacity head_load{0.0};  // Waste of the cut trip before the cut
+    Capacity tail_load{0.0};  // Waste of the cut trip after the cut
+  };
+
+  // Every cut of the route, in route order
+  [[nodiscard]] static std::pmr::vector<Cut> routeCuts(
+    const CVRoute& route,
+    const VRPTProblem& problem,
+    std::pmr::memory_resource* resource
+  ) {
+    const auto& table = problem.getLocationTable();
+    const auto& locations = route.locations();
+    std::pmr::vector<Cut> result(resource);
+
+    size_t zones_before = 0;
+    for (const auto& trip : route.trips()) {
+      Capacity head_load{0.0};
+      for (size_t pos = trip.begin;; ++pos) {
+        result.push_back({pos, zones_before, head_load, trip.load - head_load});
+        if (pos == trip.zonesEnd()) {
+          break;
+        }
+        head_load = head_load + table.wasteAmount(locations[pos]);
+        ++zones_before;
+      }
+    }
+    return result;
+  }
+};
+
+namespace {
+inline static const bool TwoOptStarSearch_registered_gen =
+  MetaHeuristicFactory<VRPTSolution, VRPTProblem, TypedAlgorithm<VRPTProblem, VRPTSolution>>::
+    registerSearch<TwoOptStarSearch>("TwoOptStarSearch");
+}
+
+}  // namespace algorithm
+}  // namespace daa
@@ -1,8 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <latch>
 #include <memory>
-#include <mutex>
+#include <optional>
 #include <random>
 #include <string>
 #include <thread>
@@ -10,7 +11,7 @@
 #include <vector>
 
 #include "algorithm_registry.h"
-#include "algorithms/greedy_tv_scheduler.h"
+#include "algorithms/incumbent_store.h"
 #include "algorithms/vrpt_solution.h"
 #include "meta_heuristic_components.h"
 #include "meta_heuristic_factory.h"
@@ -39,8 +40,7 @@ class MultiStart : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
   )
       : num_starts_(num_starts),
         generator_name_(generator_name),
-        search_names_(std::move(search_names)),
-        tv_scheduler_(std::make_unique<GreedyTVScheduler>()) {
+        search_names_(std::move(search_names)) {
     // Initialize components
     initializeComponents();
   }
@@ -61,12 +61,8 @@ class MultiStart : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
       }
     }
 
-    // Use a thread-safe container for collecting solutions
-    std::mutex solutions_mutex;
-    std::optional<VRPTSolution> best_solution;
-    size_t best_cv_count = std::numeric_limits<size_t>::max();
-    size_t best_total_vehicles = std::numeric_limits<size_t>::max();
-    double best_total_duration = std::numeric_limits<double>::max();
+    // Workers publish improvements without serializing on a lock
+    incumbent_.clear();
 
     // Create a thread pool
     const unsigned int thread_count = std::thread::hardware_concurrency();
@@ -119,6 +115,14 @@ class MultiStart : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
                 "TaskExchangeBetweenRoutesSearch"
               };
 
+              // Other selected searches follow, in the order they were selected
+              for (const auto& name : search_names_) {
+                if (std::find(search_order.begin(), search_order.end(), name) ==
+                    search_order.end()) {
+                  search_order.push_back(name);
+                }
+              }
+
               // Create a map of search names to their indices in thread_searches
               std::unordered_map<std::string, size_t> search_indices;
               for (size_t i = 0; i < search_names_.size(); ++i) {
@@ -140,90 +144,20 @@ class MultiStart : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
                 VRPTSolution candidate =
                   thread_searches[search_idx]->improveSolution(problem, current_solution);
 
-                // Check improvement
-                size_t candidate_cv_count = candidate.getCVCount();
-                double candidate_duration = candidate.totalDuration().value();
-
-                // Run TV scheduler to get total vehicle count
-                size_t candidate_total_vehicles = candidate_cv_count;
-                size_t current_total_vehicles = current_solution.getCVCount();
-
-                try {
-                  // Only run TV scheduler if CV count is not worse
-                  if (candidate_cv_count <= current_solution.getCVCount()) {
-                    // Schedule TVs for candidate
-                    VRPTSolution candidate_with_tvs = tv_scheduler_->solve({problem, candidate});
-                    candidate_total_vehicles = candidate_cv_count + candidate_with_tvs.getTVCount();
-
-                    // Schedule TVs for current solution if needed
-                    if (candidate_cv_count == current_solution.getCVCount()) {
-                      VRPTSolution current_with_tvs =
-                        tv_scheduler_->solve({problem, current_solution});
-                      current_total_vehicles =
-                        current_solution.getCVCount() + current_with_tvs.getTVCount();
-                    }
-                  }
-                } catch (const std::exception&) {
-                  // If TV scheduling fails, fall back to comparing just CV count and duration
-                }
-
-                bool is_better = false;
-                if (candidate_cv_count < current_solution.getCVCount()) {
-                  is_better = true;
-                } else if (candidate_cv_count == current_solution.getCVCount()) {
-                  if (candidate_total_vehicles < current_total_vehicles) {
-                    is_better = true;
-                  } else if (candidate_total_vehicles == current_total_vehicles &&
-                             candidate_duration < current_solution.totalDuration().value()) {
-                    is_better = true;
-                  }
-                }
+                // Keep the candidate if it uses fewer CVs, then visits more zones, then has a
+                // shorter total duration
+                const bool is_better = candidate.score().isBetterThan(current_solution.score());
 
                 if (is_better) {
-                  current_solution = candidate;
+                  current_solution = std::move(candidate);
                   improved = true;
                 }
               }
             }
           }
 
-          // Thread-safe update of best solution
-          {
-            std::lock_guard<std::mutex> lock(solutions_mutex);
-
-            double total_duration = current_solution.totalDuration().value();
-            size_t cv_count = current_solution.getCVCount();
-
-            // Run TV scheduler to get total vehicle count
-            size_t total_vehicles = cv_count;
-            try {
-              VRPTSolution solution_with_tvs = tv_scheduler_->solve({problem, current_solution});
-              total_vehicles = cv_count + solution_with_tvs.getTVCount();
-            } catch (const std::exception&) {
-              // If TV scheduling fails, just use CV count
-            }
-
-            bool is_better = false;
-            if (!best_solution) {
-              is_better = true;
-            } else if (cv_count < best_cv_count) {
-              is_better = true;
-            } else if (cv_count == best_cv_count) {
-              if (total_vehicles < best_total_vehicles) {
-                is_better = true;
-              } else if (total_vehicles == best_total_vehicles &&
-                         total_duration < best_total_duration) {
-                is_better = true;
-              }
-            }
-
-            if (is_better) {
-              best_solution = current_solution;
-              best_cv_count = cv_count;
-              best_total_vehicles = total_vehicles;
-              best_total_duration = total_duration;
-            }
-          }
+          // Publish the solution if it beats the best one found so far
+          incumbent_.offer(current_solution);
 
           // Count this start as completed
           completion_latch.count_down();
@@ -235,9 +169,15 @@ class MultiStart : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
     completion_latch.wait();
     // jthreads will automatically join when they go out of scope
 
-    return best_solution.value_or(generator_->generateSolution(problem));
+    std::optional<VRPTSolution> best_solution = incumbent_.snapshot();
+    return best_solution ? std::move(*best_solution) : generator_->generateSolution(problem);
   }
 
+  /**
+   * @brief Best solution found by the running or last solve, readable without blocking it
+   */
+  [[nodiscard]] const IncumbentStore& incumbent() const noexcept { return incumbent_; }
+
   std::string name() const override {
     return "Multi-Start-Sequential(" + std::to_string(num_starts_) + ", " + generator_name_ + ", " +
            std::to_string(search_names_.size()) + " neighborhoods)";
@@ -264,11 +204,13 @@ class MultiStart : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
   // Component instances for reuse
   std::unique_ptr<::meta::SolutionGenerator<VRPTSolution, VRPTProblem>> generator_;
   std::vector<std::unique_ptr<::meta::LocalSearch<VRPTSolution, VRPTProblem>>> local_searches_;
-  std::unique_ptr<GreedyTVScheduler> tv_scheduler_;
 
   // Map to track neighborhood search instances by name for UI configuration
   std::unordered_map<std::string, ::meta::LocalSearch<VRPTSolution, VRPTProblem>*> search_map_;
 
+  // Best solution shared by the worker threads
+  IncumbentStore incumbent_;
+
   // Initialize/update components when configuration changes
   void initializeComponents() {
     using MetaFactory =
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <bitset>
 #include <cassert>
+#include <cstdint>
 #include <random>
 #include <stdexcept>
 
@@ -14,6 +16,11 @@ namespace algorithm {
  * Uses std::bitset for efficient storage and operations on neighborhood availability.
  * Provides methods for setting/unsetting neighborhoods, checking if any are available,
  * and selecting a random available neighborhood.
+ *
+ * Each neighborhood also remembers the solution stamp (VRPTSolution::lastStamp()) at which it
+ * last found no improving move. The stamps survive resetAll(), so a neighborhood made available
+ * again can be searched over the routes changed since, or marked exhausted right away if no
+ * route changed.
  */
 template <size_t MaxNeighborhoods = 32>
 class NeighborhoodBitmap {
@@ -67,7 +74,39 @@ class NeighborhoodBitmap {
   }
 
   /**
-   * @brief Mark all neighborhoods as available
+   * @brief Mark a neighborhood as unavailable because it found no improving move
+   *
+   * @param index Neighborhood index
+   * @param stamp Last stamp of the solution it was exhausted in
+   */
+  void markExhausted(size_t index, uint64_t stamp) {
+    markUnavailable(index);
+    exhausted_at_[index] = stamp;
+  }
+
+  /**
+   * @brief Last stamp of the solution a neighborhood was last exhausted in, 0 if never
+   */
+  [[nodiscard]] uint64_t exhaustedAt(size_t index) const {
+    assert(index < count_ && "Neighborhood index out of bounds");
+    return exhausted_at_[index];
+  }
+
+  /**
+   * @brief Whether a neighborhood is known to hold no improving move for a solution
+   *
+   * True when the neighborhood was exhausted in an ancestor of the solution and no route has
+   * been replaced since.
+   *
+   * @param index Neighborhood index
+   * @param stamp Last stamp of the solution
+   */
+  [[nodiscard]] bool isExhausted(size_t index, uint64_t stamp) const {
+    return exhaustedAt(index) != 0 && stamp <= exhausted_at_[index];
+  }
+
+  /**
+   * @brief Mark all neighborhoods as available, keeping their exhaustion stamps
    */
   void resetAll() {
     for (size_t i = 0; i < count_; ++i) {
@@ -114,6 +153,7 @@ class NeighborhoodBitmap {
 
  private:
   std::bitset<MaxNeighborhoods> bitmap_;
+  std::array<uint64_t, MaxNeighborhoods> exhausted_at_{};
   size_t count_;
 };
 
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "problem/location.h"
+#include "problem/strong_types.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class RouteSegment
+ * @brief Constant-size summary of a consecutive run of CV route locations
+ *
+ * A segment records everything the CVRoute feasibility rules need about its locations: the
+ * first and last node (to price the connecting arcs), the time spent inside it, the load picked
+ * up before its first SWTS and after its last one (the open ends of the trips it cuts through),
+ * and the heaviest load and most demanding return-to-depot check inside it. Two summaries
+ * concatenate in O(1), so a candidate route assembled from pieces of existing routes is
+ * evaluated without visiting its locations.
+ *
+ * The checks match CVRoute::canVisit: every zone must fit in the remaining capacity, and after
+ * every location the vehicle must still be able to unload at the nearest SWTS and reach the
+ * depot within the maximum duration.
+ */
+class RouteSegment {
+ public:
+  // Empty segment, the identity of concat()
+  RouteSegment() = default;
+
+  /**
+   * @brief Summary of a single location
+   */
+  [[nodiscard]] static RouteSegment single(LocationIndex index, const VRPTProblem& problem) {
+    const auto& table = problem.getLocationTable();
+
+    RouteSegment segment;
+    segment.first_ = index;
+    segment.last_ = index;
+    segment.size_ = 1;
+
+    switch (table.type(index)) {
+      case LocationType::COLLECTION_ZONE:
+        segment.duration_ = table.serviceTime(index);
+        segment.head_load_ = table.wasteAmount(index);
+        segment.tail_load_ = segment.head_load_;
+        segment.peak_load_ = segment.head_load_;
+        break;
+      case LocationType::SWTS:
+        segment.has_swts_ = true;
+        break;
+      default:
+        break;
+    }
+
+    segment.return_need_ = segment.duration_ + problem.getDepotReturn(index).total;
+    return segment;
+  }
+
+  /**
+   * @brief Summary of the depot a route departs from, at time zero and with no checks
+   */
+  [[nodiscard]] static RouteSegment routeStart(const VRPTProblem& problem) {
+    RouteSegment segment;
+    segment.first_ = problem.getDepotIndex();
+    segment.last_ = segment.first_;
+    return segment;
+  }
+
+  /**
+   * @brief Summary of `a` followed by `b`, joined by the arc between them
+   */
+  [[nodiscard]] static RouteSegment
+    concat(const RouteSegment& a, const RouteSegment& b, const VRPTProblem& problem) {
+    if (b.empty()) {
+      return a;
+    }
+    if (a.empty()) {
+      return b;
+    }
+
+    // Everything in `b` happens this much later than it would on its own
+    const Duration offset = a.duration_ + problem.getTravelTime(a.last_, b.first_);
+
+    RouteSegment segment;
+    segment.first_ = a.first_;
+    segment.last_ = b.last_;
+    segment.size_ = a.size_ + b.size_;
+    segment.duration_ = offset + b.duration_;
+    segment.return_need_ = std::max(a.return_need_, offset + b.return_need_);
+
+    // The trip left open at the end of `a` continues into the head of `b`
+    segment.peak_load_ = std::max({a.peak_load_, b.peak_load_, a.tail_load_ + b.head_load_});
+    segment.head_load_ = a.has_swts_ ? a.head_load_ : a.head_load_ + b.head_load_;
+    segment.tail_load_ = b.has_swts_ ? b.tail_load_ : a.tail_load_ + b.head_load_;
+    segment.has_swts_ = a.has_swts_ || b.has_swts_;
+    return segment;
+  }
+
+  /**
+   * @brief Summary of several segments in order
+   */
+  template <typename... Segments>
+  [[nodiscard]] static RouteSegment concat(
+    const VRPTProblem& problem,
+    const RouteSegment& first,
+    const RouteSegment& second,
+    const Segments&... rest
+  ) {
+    if constexpr (sizeof...(rest) == 0) {
+      return concat(first, second, problem);
+    } else {
+      return concat(problem, concat(first, second, problem), rest...);
+    }
+  }
+
+  /**
+   * @brief Summary of a complete route made of the given segments, departing from the depot
+   */
+  template <typename... Segments>
+  [[nodiscard]] static RouteSegment route(const VRPTProblem& problem, const Segments&... segments) {
+    return concat(problem, routeStart(problem), segments...);
+  }
+
+  /**
+   * @brief Whether a summary built by route() describes a route CVRoute would accept
+   *
+   * The vehicle must never exceed its capacity, must pass every return-to-depot check and must
+   * end at the depot with all waste delivered. A route without locations is always feasible.
+   */
+  [[nodiscard]] bool isFeasibleRoute(const VRPTProblem& problem) const {
+    if (size_ == 0) {
+      return true;
+    }
+    return peak_load_ <= problem.getCVCapacity() &&
+           return_need_ <= problem.getCVMaxDuration() && tail_load_.value() == 0.0 &&
+           last_ == problem.getDepotIndex();
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return first_ == invalid_location_index; }
+
+  // Number of locations, not counting the route start
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]] LocationIndex first() const noexcept { return first_; }
+  [[nodiscard]] LocationIndex last() const noexcept { return last_; }
+
+  // Travel and service time from arriving at the first location to leaving the last one
+  [[nodiscard]] Duration duration() const noexcept { return duration_; }
+
+  // Largest time since the segment start plus depot return over its locations; the return
+  // checks pass when the segment starts no later than max duration minus this
+  [[nodiscard]] Duration returnNeed() const noexcept { return return_need_; }
+
+  // Waste collected before the first SWTS, or in the whole segment if it has none
+  [[nodiscard]] Capacity headLoad() const noexcept { return head_load_; }
+
+  // Waste still on board when leaving the segment, counted from its last SWTS
+  [[nodiscard]] Capacity tailLoad() const noexcept { return tail_load_; }
+
+  // Heaviest load reached inside the segment when it starts empty
+  [[nodiscard]] Capacity peakLoad() const noexcept { return peak_load_; }
+
+  [[nodiscard]] bool hasSWTS() const noexcept { return has_swts_; }
+
+ private:
+  LocationIndex first_{invalid_location_index};
+  LocationIndex last_{invalid_location_index};
+  std::size_t size_{0};
+  Duration duration_{};
+  Duration return_need_{};  // Max over locations of time since the start plus depot return
+  Capacity head_load_{0.0};
+  Capacity tail_load_{0.0};
+  Capacity peak_load_{0.0};
+  bool has_swts_{false};
+};
+
+}  // namespace algorithm
+}  // namespace daa
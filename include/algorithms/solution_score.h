@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "problem/strong_types.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class SolutionScore
+ * @brief Solution quality packed into a single 64-bit key, where smaller is better
+ *
+ * The key orders solutions by fewer CVs, then more zones visited, then shorter total duration,
+ * so comparing two scores is one integer comparison. From the most significant bit:
+ *
+ * | bits | field                                     |
+ * |------|-------------------------------------------|
+ * | 12   | CV count                                  |
+ * | 20   | zones not visited, out of 2^20 - 1        |
+ * | 32   | total duration in milliseconds            |
+ *
+ * Each field saturates at its maximum, so solutions beyond a field's range compare equal on it.
+ * Durations closer than a millisecond compare equal as well. The type is trivially copyable
+ * and fits in a lock-free std::atomic, so threads can track the best score without a lock.
+ */
+class SolutionScore {
+ public:
+  static constexpr unsigned cv_bits = 12;
+  static constexpr unsigned zone_bits = 20;
+  static constexpr unsigned duration_bits = 32;
+
+  static constexpr uint64_t max_cv_count = (uint64_t{1} << cv_bits) - 1;
+  static constexpr uint64_t max_zones = (uint64_t{1} << zone_bits) - 1;
+  static constexpr uint64_t max_duration_ms = (uint64_t{1} << duration_bits) - 1;
+
+  // The worst possible score
+  constexpr SolutionScore() noexcept = default;
+
+  constexpr SolutionScore(size_t cv_count, size_t zones_visited, Duration total_duration) noexcept
+      : key_(pack(cv_count, zones_visited, total_duration)) {}
+
+  [[nodiscard]] static constexpr SolutionScore fromKey(uint64_t key) noexcept {
+    SolutionScore score;
+    score.key_ = key;
+    return score;
+  }
+
+  [[nodiscard]] constexpr uint64_t key() const noexcept { return key_; }
+
+  [[nodiscard]] constexpr bool isBetterThan(const SolutionScore& other) const noexcept {
+    return key_ < other.key_;
+  }
+
+  [[nodiscard]] constexpr auto operator<=>(const SolutionScore&) const noexcept = default;
+
+  // Fields, as stored after saturation
+  [[nodiscard]] constexpr size_t cvCount() const noexcept {
+    return static_cast<size_t>(key_ >> (zone_bits + duration_bits));
+  }
+  [[nodiscard]] constexpr size_t zonesVisited() const noexcept {
+    return static_cast<size_t>(max_zones - ((key_ >> duration_bits) & max_zones));
+  }
+  [[nodiscard]] constexpr uint64_t durationMs() const noexcept {
+    return key_ & max_duration_ms;
+  }
+
+ private:
+  uint64_t key_{std::numeric_limits<uint64_t>::max()};
+
+  [[nodiscard]] static constexpr uint64_t
+    pack(size_t cv_count, size_t zones_visited, Duration total_duration) noexcept {
+    const uint64_t cv = std::min<uint64_t>(cv_count, max_cv_count);
+    const uint64_t unvisited = max_zones - std::min<uint64_t>(zones_visited, max_zones);
+    const int64_t ms = total_duration.nanoseconds() / 1'000'000;
+    const uint64_t duration = ms <= 0 ? 0 : std::min<uint64_t>(ms, max_duration_ms);
+    return (cv << (zone_bits + duration_bits)) | (unvisited << duration_bits) | duration;
+  }
+};
+
+static_assert(
+  SolutionScore::cv_bits + SolutionScore::zone_bits + SolutionScore::duration_bits == 64
+);
+static_assert(std::atomic<SolutionScore>::is_always_lock_free);
+
+}  // namespace algorithm
+}  // namespace daa
@@ -5,6 +5,7 @@
 
 #include "algorithm_registry.h"
 #include "algorithms/greedy_tv_scheduler.h"
+#include "algorithms/local_search/swts_reassignment_search.h"
 #include "algorithms/vrpt_solution.h"
 #include "problem/vrpt_problem.h"
 
@@ -41,6 +42,9 @@ class VRPTSolver : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
   VRPTSolution solve(const VRPTProblem& problem) override {
     // Phase 1: Solve the CV routing problem
     VRPTSolution cv_solution = cv_algorithm_->solve(problem);
+    if (optimize_swts_) {
+      cv_solution = SWTSReassignmentSearch::optimizeAll(problem, cv_solution);
+    }
     // Phase 2: Create TV scheduler with problem reference
     try {
       VRPTSolution final_solution = tv_algorithm_->solve({
@@ -76,6 +80,7 @@ class VRPTSolver : public TypedAlgorithm<VRPTProblem, VRPTSolution> {
  private:
   std::string cv_algorithm_name_;
   std::string tv_algorithm_name_;
+  bool optimize_swts_ = false;  // Reassign the SWTS visits of the CV routes before Phase 2
 
   std::unique_ptr<TypedAlgorithm<VRPTProblem, VRPTSolution>> cv_algorithm_;
   std::unique_ptr<TypedAlgorithm<VRPTData, VRPTSolution>> tv_algorithm_;
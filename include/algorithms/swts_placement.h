@@ -0,0 +1,53 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "problem/location.h"
+#include "problem/strong_types.h"
+#include "problem/vrpt_problem.h"
+
+namespace daa {
+namespace algorithm {
+
+/**
+ * @class SWTSPlacement
+ * @brief Shortest CV route serving a fixed sequence of zones, choosing where it unloads
+ *
+ * Generators end a trip at the nearest SWTS (GreedyCVGenerator) or at a randomized pick
+ * (GRASPCVGenerator), and the zone neighborhoods keep the SWTS visits where they are. optimal()
+ * keeps the zone order and chooses both where the trips break and the SWTS closing each one,
+ * minimizing the route duration under the CVRoute capacity and return-to-depot rules.
+ *
+ * It is a Bellman shortest path over an auxiliary graph whose nodes are the trip breaks. Arrival
+ * labels are the earliest times, and every check only gets harder later in the route, so the
+ * earliest label dominates. Each break is reached from the best trip ending there, built from
+ * RouteSegment concatenations, and then continued through the SWTS that best joins its last
+ * zone to the next zone. The cost is O(n * (|SWTS| + b)), where b is the most zones a trip can
+ * hold.
+ */
+class SWTSPlacement {
+ public:
+  /**
+   * @brief Best route serving the zones in order, or nullopt if no feasible route does
+   */
+  [[nodiscard]] static std::optional<SWTSPlacement>
+    optimal(std::span<const LocationIndex> zones, const VRPTProblem& problem);
+
+  // Zones and SWTS visits in order, ending at the depot
+  [[nodiscard]] const std::vector<LocationIndex>& locations() const noexcept { return locations_; }
+
+  [[nodiscard]] Duration duration() const noexcept { return duration_; }
+
+ private:
+  SWTSPlacement(std::vector<LocationIndex> locations, Duration duration)
+      : locations_(std::move(locations)), duration_(duration) {}
+
+  std::vector<LocationIndex> locations_;
+  Duration duration_;
+};
+
+}  // namespace algorithm
+}  // namespace daa
@@ -1,11 +1,17 @@
 #pragma once
 
-#include <optional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "algorithms/route_segment.h"
+#include "algorithms/solution_score.h"
 #include "problem/location.h"
 #include "problem/strong_types.h"
 #include "problem/vrpt_problem.h"
@@ -18,18 +24,18 @@ namespace algorithm {
  */
 class DeliveryTask {
  public:
-  DeliveryTask(Capacity amount, std::string swts_id, Duration arrival_time)
-      : amount_(amount), swts_id_(std::move(swts_id)), arrival_time_(arrival_time) {}
+  DeliveryTask(Capacity amount, LocationIndex swts, Duration arrival_time)
+      : amount_(amount), swts_(swts), arrival_time_(arrival_time) {}
 
   [[nodiscard]] const Capacity& amount() const { return amount_; }
-  [[nodiscard]] const std::string& swtsId() const { return swts_id_; }
+  [[nodiscard]] LocationIndex swts() const { return swts_; }
   [[nodiscard]] const Duration& arrivalTime() const { return arrival_time_; }
 
   /**
    * @brief Equality operator
    */
   bool operator==(const DeliveryTask& other) const {
-    return amount_ == other.amount_ && swts_id_ == other.swts_id_ &&
+    return amount_ == other.amount_ && swts_ == other.swts_ &&
            arrival_time_ == other.arrival_time_;
   }
 
@@ -40,12 +46,37 @@ class DeliveryTask {
 
  private:
   Capacity amount_;        // Amount of waste delivered
-  std::string swts_id_;    // SWTS location ID
+  LocationIndex swts_;     // SWTS location index
   Duration arrival_time_;  // Time when the CV arrives
 };
 
+/**
+ * @brief One trip of a CV route: zones served in a row and the stop closing them
+ *
+ * A trip runs from the depot or the previous stop through its zones to the SWTS where the
+ * vehicle unloads, or to the depot at the end of the route. Zones occupy the positions before
+ * the stop, so a trip tells which positions hold zones without looking up location types.
+ */
+struct RouteTrip {
+  size_t begin{0};                             // Position of the first location
+  size_t end{0};                               // One past the last location, stop included
+  LocationIndex stop{invalid_location_index};  // Location closing the trip, invalid while open
+  Capacity load{0.0};                          // Waste collected from the zones
+  Duration duration{};   // From leaving the previous stop to leaving the last location
+  RouteSegment segment;  // Summary of the locations, without the arc into the first one
+
+  [[nodiscard]] bool isClosed() const noexcept { return stop != invalid_location_index; }
+
+  // Positions [begin, zonesEnd()) hold the zones of the trip
+  [[nodiscard]] size_t zonesEnd() const noexcept { return isClosed() ? end - 1 : end; }
+  [[nodiscard]] size_t zoneCount() const noexcept { return zonesEnd() - begin; }
+};
+
 /**
  * @brief Class representing a collection vehicle route
+ *
+ * Besides the flat location sequence, the route keeps it split into trips (see RouteTrip) with
+ * their load, duration and summary, maintained as locations are added.
  */
 class CVRoute {
  public:
@@ -54,97 +85,147 @@ class CVRoute {
     // Start with empty load and zero time
     load_profile_.push_back(Capacity{0.0});
     time_profile_.push_back(Duration{0.0});
-    duration_profile_.push_back(Duration{0.0});
+    prefix_segments_.emplace_back();
   }
 
-  void addLocation(const std::string& location_id, const VRPTProblem& problem) {
+  void addLocation(LocationIndex location_index, const VRPTProblem& problem) {
     // Get the previous location if any
-    std::string prev_id = location_ids_.empty() ? problem.getDepot().id() : location_ids_.back();
-    const auto& location = problem.getLocation(location_id);
+    LocationIndex prev = locations_.empty() ? problem.getDepotIndex() : locations_.back();
+    const auto& table = problem.getLocationTable();
+    const LocationType type = table.type(location_index);
 
     // Calculate travel time from previous location
-    Duration travel_time = problem.getTravelTime(prev_id, location_id);
+    Duration travel_time = problem.getTravelTime(prev, location_index);
 
     // Update total duration
     total_duration_ = total_duration_ + travel_time;
 
-    if (location.type() == LocationType::COLLECTION_ZONE) {
+    if (type == LocationType::COLLECTION_ZONE) {
       // Add waste from the zone and service time
-      current_load_ = current_load_ + location.wasteAmount();
-      total_duration_ = total_duration_ + location.serviceTime();
-    } else if (location.type() == LocationType::SWTS) {
+      current_load_ = current_load_ + table.wasteAmount(location_index);
+      total_duration_ = total_duration_ + table.serviceTime(location_index);
+      zones_.push_back(location_index);
+    } else if (type == LocationType::SWTS) {
       // Record delivery at this SWTS
-      deliveries_.emplace_back(current_load_, location_id, total_duration_);
+      deliveries_.emplace_back(current_load_, location_index, total_duration_);
 
       // Reset load after unloading at SWTS
       current_load_ = Capacity{0.0};
     }
 
+    // Extend the open trip, or start one after a stop
+    if (trips_.empty() || trips_.back().isClosed()) {
+      auto& started = trips_.emplace_back();
+      started.begin = locations_.size();
+      started.end = locations_.size();
+    }
+    auto& trip = trips_.back();
+    ++trip.end;
+    trip.duration += travel_time;
+    trip.segment =
+      RouteSegment::concat(trip.segment, RouteSegment::single(location_index, problem), problem);
+    if (type == LocationType::COLLECTION_ZONE) {
+      trip.load = trip.load + table.wasteAmount(location_index);
+      trip.duration += table.serviceTime(location_index);
+    } else {
+      trip.stop = location_index;
+    }
+
     // Add location to route
-    location_ids_.push_back(location_id);
+    locations_.push_back(location_index);
 
     // Update profiles
     load_profile_.push_back(current_load_);
     time_profile_.push_back(total_duration_);
-    duration_profile_.push_back(total_duration_);
+    prefix_segments_.push_back(RouteSegment::concat(
+      prefix_segments_.back(), RouteSegment::single(location_index, problem), problem
+    ));
   }
 
-  [[nodiscard]] bool canVisit(const std::string& location_id, const VRPTProblem& problem) const {
+  [[nodiscard]] bool canVisit(LocationIndex location_index, const VRPTProblem& problem) const {
     // Check capacity constraints
-    const auto& location = problem.getLocation(location_id);
+    const auto& table = problem.getLocationTable();
+    const LocationType type = table.type(location_index);
 
     // If this is a collection zone, make sure we have enough capacity
-    if (location.type() == LocationType::COLLECTION_ZONE &&
-        current_load_ + location.wasteAmount() > max_capacity_) {
+    if (type == LocationType::COLLECTION_ZONE &&
+        current_load_ + table.wasteAmount(location_index) > max_capacity_) {
       return false;
     }
 
     // Get the previous location
-    std::string prev_id = location_ids_.empty() ? problem.getDepot().id() : location_ids_.back();
+    LocationIndex prev = locations_.empty() ? problem.getDepotIndex() : locations_.back();
 
     // Calculate travel time to the new location
-    Duration travel_time = problem.getTravelTime(prev_id, location_id);
+    Duration travel_time = problem.getTravelTime(prev, location_index);
     Duration total_time = total_duration_ + travel_time;
 
-    if (location.type() == LocationType::COLLECTION_ZONE) {
-      total_time = total_time + location.serviceTime();
+    if (type == LocationType::COLLECTION_ZONE) {
+      total_time = total_time + table.serviceTime(location_index);
     }
 
-    // Check time to return to depot after visiting this location
-    std::optional<Location> nearest_swts;
-    if (location.type() != LocationType::SWTS) {
-      nearest_swts = problem.findNearest(location, LocationType::SWTS);
-    }
-
-    Duration return_time;
-    if (nearest_swts) {
-      return_time = problem.getTravelTime(location_id, nearest_swts->id()) +
-                    problem.getTravelTime(nearest_swts->id(), problem.getDepot().id());
-    } else {
-      return_time = problem.getTravelTime(location_id, problem.getDepot().id());
-    }
+    // Check time to return to depot after visiting this location, unloading at the nearest SWTS
+    Duration return_time = problem.getDepotReturn(location_index).total;
 
     // Check if we can visit location and still return to depot within time limit
     return (total_time + return_time) <= max_duration_;
   }
 
   // Getters
-  [[nodiscard]] const std::vector<std::string>& locationIds() const { return location_ids_; }
+  [[nodiscard]] const std::vector<LocationIndex>& locations() const { return locations_; }
   [[nodiscard]] const std::string& vehicleId() const { return vehicle_id_; }
   [[nodiscard]] Capacity currentLoad() const { return current_load_; }
   [[nodiscard]] Duration totalDuration() const { return total_duration_; }
   [[nodiscard]] const std::vector<DeliveryTask>& deliveries() const { return deliveries_; }
-  [[nodiscard]] bool isEmpty() const { return location_ids_.empty(); }
+  [[nodiscard]] bool isEmpty() const { return locations_.empty(); }
+
+  // Collection zones in visit order
+  [[nodiscard]] const std::vector<LocationIndex>& zones() const { return zones_; }
+
+  // Get the last location, or invalid_location_index for an empty route
+  [[nodiscard]] LocationIndex lastLocation() const {
+    return locations_.empty() ? invalid_location_index : locations_.back();
+  }
+
+  /**
+   * @brief Summary of the first `count` locations, without the departure from the depot
+   */
+  [[nodiscard]] const RouteSegment& prefix(size_t count) const { return prefix_segments_[count]; }
+
+  /**
+   * @brief Summaries of every suffix: entry `k` covers the locations from position `k` on, and
+   * the last entry is empty
+   */
+  [[nodiscard]] std::pmr::vector<RouteSegment> suffixes(
+    const VRPTProblem& problem,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+  ) const {
+    std::pmr::vector<RouteSegment> result(locations_.size() + 1, resource);
+    for (size_t k = locations_.size(); k-- > 0;) {
+      result[k] =
+        RouteSegment::concat(RouteSegment::single(locations_[k], problem), result[k + 1], problem);
+    }
+    return result;
+  }
 
-  // Get the last location
-  [[nodiscard]] std::string lastLocationId() const {
-    return location_ids_.empty() ? "" : location_ids_.back();
+  /**
+   * @brief Summary of the locations at positions [begin, end)
+   */
+  [[nodiscard]] RouteSegment segment(size_t begin, size_t end, const VRPTProblem& problem) const {
+    RouteSegment result;
+    for (size_t k = begin; k < end; ++k) {
+      result = RouteSegment::concat(result, RouteSegment::single(locations_[k], problem), problem);
+    }
+    return result;
   }
 
+  // Trips in visit order; the last one is open if the route does not end at a stop
+  [[nodiscard]] const std::vector<RouteTrip>& trips() const noexcept { return trips_; }
+
   // Validate route
   [[nodiscard]] bool isValid(const VRPTProblem& _) const {
     // Check if route is empty
-    if (location_ids_.empty()) {
+    if (locations_.empty()) {
       return true;  // Empty route is considered valid
     }
 
@@ -175,7 +256,7 @@ class CVRoute {
    * @return True if the routes are identical
    */
   bool operator==(const CVRoute& other) const {
-    return vehicle_id_ == other.vehicle_id_ && location_ids_ == other.location_ids_ &&
+    return vehicle_id_ == other.vehicle_id_ && locations_ == other.locations_ &&
            current_load_ == other.current_load_ && total_duration_ == other.total_duration_ &&
            deliveries_ == other.deliveries_;
   }
@@ -188,16 +269,18 @@ class CVRoute {
   bool operator!=(const CVRoute& other) const { return !(*this == other); }
 
  private:
-  std::vector<std::string> location_ids_;   // Sequence of location IDs (zones, SWTS, depot)
-  std::string vehicle_id_;                  // Vehicle ID
-  Capacity max_capacity_;                   // Maximum capacity of the vehicle
-  Duration max_duration_;                   // Maximum duration of the route
-  Duration total_duration_{0.0};            // Current total duration
-  Capacity current_load_{0.0};              // Current load at each step
-  std::vector<Capacity> load_profile_;      // Load at each step of the route
-  std::vector<Duration> time_profile_;      // Time at each step of the route
-  std::vector<Duration> duration_profile_;  // Cumulative duration at each step
-  std::vector<DeliveryTask> deliveries_;    // Waste deliveries at SWTS
+  std::vector<LocationIndex> locations_;       // Sequence of location indices (zones, SWTS, depot)
+  std::string vehicle_id_;                     // Vehicle ID
+  Capacity max_capacity_;                      // Maximum capacity of the vehicle
+  Duration max_duration_;                      // Maximum duration of the route
+  Duration total_duration_{0.0};               // Current total duration
+  Capacity current_load_{0.0};                 // Current load at each step
+  std::vector<Capacity> load_profile_;         // Load at each step of the route
+  std::vector<Duration> time_profile_;         // Time at each step of the route
+  std::vector<DeliveryTask> deliveries_;       // Waste deliveries at SWTS
+  std::vector<LocationIndex> zones_;           // Collection zones in visit order
+  std::vector<RouteSegment> prefix_segments_;  // Summary of the first k locations at index k
+  std::vector<RouteTrip> trips_;               // The locations split into trips
 };
 
 /**
@@ -213,16 +296,16 @@ class TVRoute {
   }
 
   bool addPickup(
-    const std::string& swts_id,
+    LocationIndex swts,
     const Duration& arrival_time,
     const Capacity& amount,
     const VRPTProblem& problem
   ) {
     // Get the previous location
-    std::string prev_id = location_ids_.empty() ? problem.getLandfill().id() : location_ids_.back();
+    LocationIndex prev = locations_.empty() ? problem.getLandfillIndex() : locations_.back();
 
     // Calculate travel time to the SWTS
-    Duration travel_time = problem.getTravelTime(prev_id, swts_id);
+    Duration travel_time = problem.getTravelTime(prev, swts);
 
     // Update current time based on travel time
     Duration new_time = current_time_ + travel_time;
@@ -234,14 +317,14 @@ class TVRoute {
     }
 
     // Add SWTS to route
-    location_ids_.push_back(swts_id);
+    locations_.push_back(swts);
 
     // Update current time and load
     current_time_ = new_time;
     current_load_ = current_load_ + amount;
 
     // Record pickup details
-    pickups_.emplace_back(swts_id, arrival_time);
+    pickups_.emplace_back(swts, arrival_time);
 
     // Update profiles
     load_profile_.push_back(current_load_);
@@ -250,30 +333,31 @@ class TVRoute {
     return true;
   }
 
-  bool addLocation(const std::string& location_id, const VRPTProblem& problem) {
+  bool addLocation(LocationIndex location_index, const VRPTProblem& problem) {
+    const LocationIndex landfill = problem.getLandfillIndex();
+
     // Get the previous location
-    std::string prev_id = location_ids_.empty() ? problem.getLandfill().id() : location_ids_.back();
+    LocationIndex prev = locations_.empty() ? landfill : locations_.back();
 
     // Calculate travel time
-    Duration travel_time = problem.getTravelTime(prev_id, location_id);
+    Duration travel_time = problem.getTravelTime(prev, location_index);
 
     // Update current time
     current_time_ = current_time_ + travel_time;
 
     // If this is a landfill, reset the load
-    if (location_id == problem.getLandfill().id()) {
+    if (location_index == landfill) {
       current_load_ = Capacity{0.0};
     }
 
     // Check time constraint
     // Skip the time constraint check if going to the landfill
-    if (location_id != problem.getLandfill().id() &&
-        current_time_ > max_duration_ + problem.getEpsilon()) {
+    if (location_index != landfill && current_time_ > max_duration_ + problem.getEpsilon()) {
       return false;
     }
 
     // Add location to route
-    location_ids_.push_back(location_id);
+    locations_.push_back(location_index);
 
     // Update profiles
     load_profile_.push_back(current_load_);
@@ -285,27 +369,27 @@ class TVRoute {
   // Finalize the route by returning to the landfill if needed
   bool finalize(const VRPTProblem& problem) {
     // If already at landfill or empty route, nothing to do
-    if (location_ids_.empty() || location_ids_.back() == problem.getLandfill().id()) {
+    if (locations_.empty() || locations_.back() == problem.getLandfillIndex()) {
       return true;
     }
 
     // Add landfill as final destination
-    return addLocation(problem.getLandfill().id(), problem);
+    return addLocation(problem.getLandfillIndex(), problem);
   }
 
   // Getters
-  [[nodiscard]] const std::vector<std::string>& locationIds() const { return location_ids_; }
+  [[nodiscard]] const std::vector<LocationIndex>& locations() const { return locations_; }
   [[nodiscard]] const std::string& vehicleId() const { return vehicle_id_; }
   [[nodiscard]] Capacity currentLoad() const { return current_load_; }
   [[nodiscard]] Duration currentTime() const { return current_time_; }
-  [[nodiscard]] const std::vector<std::pair<std::string, Duration>>& pickups() const {
+  [[nodiscard]] const std::vector<std::pair<LocationIndex, Duration>>& pickups() const {
     return pickups_;
   }
-  [[nodiscard]] bool isEmpty() const { return location_ids_.empty(); }
+  [[nodiscard]] bool isEmpty() const { return locations_.empty(); }
 
-  // Get the last location
-  [[nodiscard]] std::string lastLocationId() const {
-    return location_ids_.empty() ? "" : location_ids_.back();
+  // Get the last location, or invalid_location_index for an empty route
+  [[nodiscard]] LocationIndex lastLocation() const {
+    return locations_.empty() ? invalid_location_index : locations_.back();
   }
 
   // Residual capacity
@@ -314,7 +398,7 @@ class TVRoute {
   // Validate route
   [[nodiscard]] bool isValid(const VRPTProblem& problem) const {
     // Check if route is empty
-    if (location_ids_.empty()) {
+    if (locations_.empty()) {
       return true;
     }
 
@@ -327,7 +411,7 @@ class TVRoute {
 
     // Check that total duration is within limit and route ends at landfill
     return current_time_ <= max_duration_ &&
-           (location_ids_.empty() || location_ids_.back() == problem.getLandfill().id());
+           (locations_.empty() || locations_.back() == problem.getLandfillIndex());
   }
 
   /**
@@ -336,7 +420,7 @@ class TVRoute {
    * @return True if the routes are identical
    */
   bool operator==(const TVRoute& other) const {
-    return vehicle_id_ == other.vehicle_id_ && location_ids_ == other.location_ids_ &&
+    return vehicle_id_ == other.vehicle_id_ && locations_ == other.locations_ &&
            current_load_ == other.current_load_ && current_time_ == other.current_time_ &&
            pickups_ == other.pickups_;
   }
@@ -349,94 +433,286 @@ class TVRoute {
   bool operator!=(const TVRoute& other) const { return !(*this == other); }
 
  private:
-  std::vector<std::string> location_ids_;  // Sequence of location IDs (SWTS, landfill)
-  std::string vehicle_id_;                 // Vehicle ID
-  Capacity max_capacity_;                  // Maximum capacity of the vehicle
-  Duration max_duration_;                  // Maximum duration of the route
-  Duration current_time_{0.0};             // Current time at each step
-  Capacity current_load_{0.0};             // Current load at each step
-  std::vector<Capacity> load_profile_;     // Load at each step of the route
-  std::vector<Duration> time_profile_;     // Time at each step of the route
-  std::vector<std::pair<std::string, Duration>> pickups_;  // SWTS pickups with time constraints
+  std::vector<LocationIndex> locations_;  // Sequence of location indices (SWTS, landfill)
+  std::string vehicle_id_;                // Vehicle ID
+  Capacity max_capacity_;                 // Maximum capacity of the vehicle
+  Duration max_duration_;                 // Maximum duration of the route
+  Duration current_time_{0.0};            // Current time at each step
+  Capacity current_load_{0.0};            // Current load at each step
+  std::vector<Capacity> load_profile_;    // Load at each step of the route
+  std::vector<Duration> time_profile_;    // Time at each step of the route
+  std::vector<std::pair<LocationIndex, Duration>> pickups_;  // SWTS pickups with time constraints
+};
+
+/**
+ * @brief Read-only view of the CV routes of a solution
+ *
+ * Solutions hold their CV routes through shared handles; the view presents them as a sequence
+ * of routes, so callers index and iterate it like a vector of CVRoute.
+ */
+class CVRouteList {
+ public:
+  using Handle = std::shared_ptr<const CVRoute>;
+
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = CVRoute;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CVRoute*;
+    using reference = const CVRoute&;
+
+    Iterator() = default;
+    explicit Iterator(const Handle* handle) : handle_(handle) {}
+
+    reference operator*() const { return **handle_; }
+    pointer operator->() const { return handle_->get(); }
+    reference operator[](difference_type n) const { return *handle_[n]; }
+
+    Iterator& operator++() {
+      ++handle_;
+      return *this;
+    }
+    Iterator operator++(int) { return Iterator(handle_++); }
+    Iterator& operator--() {
+      --handle_;
+      return *this;
+    }
+    Iterator operator--(int) { return Iterator(handle_--); }
+    Iterator& operator+=(difference_type n) {
+      handle_ += n;
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+      handle_ -= n;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+      return a.handle_ - b.handle_;
+    }
+    friend auto operator<=>(const Iterator&, const Iterator&) = default;
+
+   private:
+    const Handle* handle_{nullptr};
+  };
+
+  explicit CVRouteList(const std::vector<Handle>& routes) : routes_(&routes) {}
+
+  [[nodiscard]] size_t size() const noexcept { return routes_->size(); }
+  [[nodiscard]] bool empty() const noexcept { return routes_->empty(); }
+
+  [[nodiscard]] const CVRoute& operator[](size_t index) const { return *(*routes_)[index]; }
+  [[nodiscard]] const CVRoute& front() const { return *routes_->front(); }
+  [[nodiscard]] const CVRoute& back() const { return *routes_->back(); }
+
+  [[nodiscard]] Iterator begin() const { return Iterator(routes_->data()); }
+  [[nodiscard]] Iterator end() const { return Iterator(routes_->data() + routes_->size()); }
+
+  // Routes compare by content; shared handles compare equal without looking inside
+  bool operator==(const CVRouteList& other) const {
+    return std::equal(
+      routes_->begin(),
+      routes_->end(),
+      other.routes_->begin(),
+      other.routes_->end(),
+      [](const Handle& a, const Handle& b) { return a == b || *a == *b; }
+    );
+  }
+
+ private:
+  const std::vector<Handle>* routes_;
+};
+
+/**
+ * @brief Delivery tasks of a set of CV routes, merged lazily in arrival order
+ *
+ * Each route records its deliveries in the order it makes them, so a heap holding the next
+ * delivery of every route yields all of them in arrival order without copying or sorting, at
+ * O(log k) per task for k routes. Deliveries arriving at the same time come in route order.
+ *
+ * The stream points into the routes themselves: it must not outlive the solution it reads, and
+ * is invalidated when that solution's CV routes change.
+ */
+class DeliveryTaskStream {
+ public:
+  explicit DeliveryTaskStream(const CVRouteList& routes) {
+    heap_.reserve(routes.size());
+    for (size_t i = 0; i < routes.size(); ++i) {
+      const auto& deliveries = routes[i].deliveries();
+      if (!deliveries.empty()) {
+        heap_.push_back({deliveries.data(), deliveries.data() + deliveries.size(), i});
+      }
+    }
+    std::ranges::make_heap(heap_, isLater);
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return heap_.empty(); }
+
+  // Earliest task not taken yet; the stream must not be empty
+  [[nodiscard]] const DeliveryTask& front() const { return *heap_.front().next; }
+
+  // Take the earliest task; references to it stay valid
+  void pop() {
+    std::ranges::pop_heap(heap_, isLater);
+    auto& cursor = heap_.back();
+    if (++cursor.next == cursor.end) {
+      heap_.pop_back();
+    } else {
+      std::ranges::push_heap(heap_, isLater);
+    }
+  }
+
+ private:
+  struct Cursor {
+    const DeliveryTask* next;  // Next delivery of the route
+    const DeliveryTask* end;
+    size_t route;
+  };
+
+  // Heap order, putting the cursor with the earliest task on top
+  static bool isLater(const Cursor& a, const Cursor& b) {
+    if (a.next->arrivalTime() != b.next->arrivalTime()) {
+      return b.next->arrivalTime() < a.next->arrivalTime();
+    }
+    return b.route < a.route;
+  }
+
+  std::vector<Cursor> heap_;
 };
 
 /**
  * @brief Complete solution for the VRPT problem
+ *
+ * Routes are only modified through the mutators below, which keep the total duration and the
+ * zones visited up to date incrementally instead of rescanning every route on each query.
+ * Every CV route slot carries a stamp that changes whenever the route in it is replaced, so
+ * callers can tell which routes changed since they last looked.
+ *
+ * CV routes are immutable once added and held through shared handles, so copying a solution
+ * copies one pointer per route, and the copies share every route until one of them replaces it.
  */
 class VRPTSolution {
  public:
   // Add a CV route
-  void addCVRoute(CVRoute route) { cv_routes_.push_back(std::move(route)); }
+  void addCVRoute(CVRoute route) { addCVRoute(std::make_shared<const CVRoute>(std::move(route))); }
+
+  // Add a CV route shared with other solutions
+  void addCVRoute(CVRouteList::Handle route) {
+    account(*route, 1);
+    cv_routes_.push_back(std::move(route));
+    cv_stamps_.push_back(++last_stamp_);
+  }
+
+  // Replace the CV route at an index
+  void replaceCVRoute(size_t index, CVRoute route) {
+    replaceCVRoute(index, std::make_shared<const CVRoute>(std::move(route)));
+  }
+
+  // Replace the CV route at an index with one shared with other solutions
+  void replaceCVRoute(size_t index, CVRouteList::Handle route) {
+    account(*cv_routes_[index], -1);
+    account(*route, 1);
+    cv_routes_[index] = std::move(route);
+    cv_stamps_[index] = ++last_stamp_;
+  }
+
+  // Remove the CV route at an index, shifting the later ones down
+  void removeCVRoute(size_t index) {
+    account(*cv_routes_[index], -1);
+    cv_routes_.erase(cv_routes_.begin() + static_cast<std::ptrdiff_t>(index));
+    cv_stamps_.erase(cv_stamps_.begin() + static_cast<std::ptrdiff_t>(index));
+  }
+
+  // Remove every CV route without locations, returning how many were removed
+  size_t removeEmptyCVRoutes() {
+    size_t kept = 0;
+    for (size_t i = 0; i < cv_routes_.size(); ++i) {
+      if (cv_routes_[i]->isEmpty()) {
+        continue;
+      }
+      if (kept != i) {
+        cv_routes_[kept] = std::move(cv_routes_[i]);
+        cv_stamps_[kept] = cv_stamps_[i];
+      }
+      ++kept;
+    }
+
+    const size_t removed = cv_routes_.size() - kept;
+    cv_routes_.erase(cv_routes_.begin() + static_cast<std::ptrdiff_t>(kept), cv_routes_.end());
+    cv_stamps_.resize(kept);
+    return removed;
+  }
 
   // Add a TV route
   void addTVRoute(TVRoute route) { tv_routes_.push_back(std::move(route)); }
 
-  // Get all delivery tasks from CV routes
-  [[nodiscard]] std::vector<DeliveryTask> getAllDeliveryTasks() const {
-    std::vector<DeliveryTask> all_tasks;
+  // Remove all TV routes
+  void clearTVRoutes() { tv_routes_.clear(); }
 
-    for (const auto& route : cv_routes_) {
-      const auto& deliveries = route.deliveries();
-      all_tasks.insert(all_tasks.end(), deliveries.begin(), deliveries.end());
-    }
+  /**
+   * @brief Stamp of the CV route at an index
+   *
+   * Stamps increase with every route added or replaced, so a route whose stamp is at most a
+   * value recorded earlier from lastStamp() has not changed since.
+   */
+  [[nodiscard]] uint64_t cvRouteStamp(size_t index) const { return cv_stamps_[index]; }
 
-    // Sort by arrival time
-    std::sort(all_tasks.begin(), all_tasks.end(), [](const DeliveryTask& a, const DeliveryTask& b) {
-      return a.arrivalTime() < b.arrivalTime();
-    });
+  // Most recent stamp handed out
+  [[nodiscard]] uint64_t lastStamp() const noexcept { return last_stamp_; }
 
-    return all_tasks;
+  // Delivery tasks of all CV routes in arrival order, merged as they are read
+  [[nodiscard]] DeliveryTaskStream deliveryTasks() const {
+    return DeliveryTaskStream(getCVRoutes());
   }
 
-  // Calculate total duration across all CV routes
-  [[nodiscard]] Duration totalDuration() const {
-    Duration total{0.0};
-    for (const auto& duration : cv_routes_ | std::views::transform(&CVRoute::totalDuration)) {
-      total = total + duration;
+  // Copy of all delivery tasks from CV routes, sorted by arrival time
+  [[nodiscard]] std::vector<DeliveryTask> getAllDeliveryTasks() const {
+    std::vector<DeliveryTask> all_tasks;
+    for (auto tasks = deliveryTasks(); !tasks.empty(); tasks.pop()) {
+      all_tasks.push_back(tasks.front());
     }
-    return total;
+    return all_tasks;
   }
 
-  // Count unique collection zones visited across all routes
-  [[nodiscard]] size_t visitedZones(const VRPTProblem& problem) const {
-    std::unordered_set<std::string> visited_zones;
-
-    auto is_collection_zone = [&problem](const std::string& id) {
-      try {
-        return problem.getLocation(id).type() == LocationType::COLLECTION_ZONE;
-      } catch (const std::exception&) {
-        return false;
-      }
-    };
+  // Total duration across all CV routes
+  [[nodiscard]] Duration totalDuration() const noexcept { return total_duration_; }
 
-    for (const auto& route : cv_routes_) {
-      for (const auto& id : route.locationIds() | std::views::filter(is_collection_zone)) {
-        visited_zones.insert(id);
-      }
-    }
+  // Count unique collection zones visited across all routes
+  [[nodiscard]] size_t visitedZones() const noexcept { return visited_zones_; }
+  [[nodiscard]] size_t visitedZones(const VRPTProblem& /*problem*/) const noexcept {
+    return visited_zones_;
+  }
 
-    return visited_zones.size();
+  // Packed quality key built from the cached metrics; smaller is better
+  [[nodiscard]] SolutionScore score() const noexcept {
+    return {cv_routes_.size(), visited_zones_, total_duration_};
   }
 
   // Getters
-  [[nodiscard]] const std::vector<CVRoute>& getCVRoutes() const { return cv_routes_; }
-  [[nodiscard]] std::vector<CVRoute>& getCVRoutes() { return cv_routes_; }
+  [[nodiscard]] CVRouteList getCVRoutes() const { return CVRouteList(cv_routes_); }
 
+  // Shared handle to the CV route at an index, to reuse it in another solution
+  [[nodiscard]] const CVRouteList::Handle& cvRouteHandle(size_t index) const {
+    return cv_routes_[index];
+  }
   [[nodiscard]] const std::vector<TVRoute>& getTVRoutes() const { return tv_routes_; }
-  [[nodiscard]] std::vector<TVRoute>& getTVRoutes() { return tv_routes_; }
 
   [[nodiscard]] bool isComplete() const { return is_complete_; }
   void setComplete(bool complete) { is_complete_ = complete; }
 
   // Count number of vehicles used
-  [[nodiscard]] size_t getCVCount() const { return cv_routes_.size(); }
-  [[nodiscard]] size_t getTVCount() const { return tv_routes_.size(); }
+  [[nodiscard]] size_t getCVCount() const noexcept { return cv_routes_.size(); }
+  [[nodiscard]] size_t getTVCount() const noexcept { return tv_routes_.size(); }
 
   // Calculate total waste collected (for validation)
   [[nodiscard]] Capacity totalWasteCollected() const {
     Capacity total{0.0};
     for (const auto& route : cv_routes_) {
-      for (const auto& delivery : route.deliveries()) {
+      for (const auto& delivery : route->deliveries()) {
         total = total + delivery.amount();
       }
     }
@@ -447,7 +723,7 @@ class VRPTSolution {
   [[nodiscard]] bool isValid(const VRPTProblem& problem) const {
     // Check if all CV routes are valid
     for (const auto& route : cv_routes_) {
-      if (!route.isValid(problem)) {
+      if (!route->isValid(problem)) {
         return false;
       }
     }
@@ -495,9 +771,34 @@ class VRPTSolution {
   bool operator!=(const VRPTSolution& other) const { return !(*this == other); }
 
  private:
-  std::vector<CVRoute> cv_routes_;  // Collection vehicle routes
-  std::vector<TVRoute> tv_routes_;  // Transportation vehicle routes
-  bool is_complete_ = false;        // Flag indicating if both phases are solved
+  std::vector<CVRouteList::Handle> cv_routes_;  // Collection vehicle routes
+  std::vector<uint64_t> cv_stamps_;             // Stamp of each CV route
+  std::vector<TVRoute> tv_routes_;              // Transportation vehicle routes
+  bool is_complete_ = false;                    // Flag indicating if both phases are solved
+  uint64_t last_stamp_{0};                      // Most recent CV route stamp
+  Duration total_duration_{};                   // Sum of the CV route durations
+  std::vector<uint32_t> zone_visits_;           // Routes visiting each zone, by LocationIndex
+  size_t visited_zones_{0};                     // Zones with at least one visit
+
+  // Add (sign 1) or remove (sign -1) a route's contribution to the cached metrics
+  void account(const CVRoute& route, int sign) {
+    if (sign > 0) {
+      total_duration_ += route.totalDuration();
+    } else {
+      total_duration_ -= route.totalDuration();
+    }
+
+    for (const auto zone : route.zones()) {
+      if (zone >= zone_visits_.size()) {
+        zone_visits_.resize(zone + 1, 0);
+      }
+      if (sign > 0) {
+        visited_zones_ += zone_visits_[zone]++ == 0 ? 1 : 0;
+      } else {
+        visited_zones_ -= --zone_visits_[zone] == 0 ? 1 : 0;
+      }
+    }
+  }
 };
 
 }  // namespace algorithm
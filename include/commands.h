@@ -15,6 +15,7 @@
 // IWYU pragma: begin_exports
 #include "commands/benchmark.h"
 #include "commands/compare.h"
+#include "commands/kdtree_benchmark.h"
 #include "commands/list.h"
 #include "commands/validate.h"
 #include "commands/visualize.h"
@@ -23,7 +23,10 @@ class BenchmarkCommand : public CommandHandlerBase<BenchmarkCommand> {
     std::vector<std::string> input_files,
     bool verbose,
     bool debug,
-    int time_limit_ms = Algorithm::DEFAULT_TIME_LIMIT_MS
+    int time_limit_ms = Algorithm::DEFAULT_TIME_LIMIT_MS,
+    bool granular = false,
+    int granular_neighbors = 8,
+    double granular_threshold = 1.5
   )
       : CommandHandlerBase(verbose),
         algo_name_(std::move(algo_name)),
@@ -31,7 +34,10 @@ class BenchmarkCommand : public CommandHandlerBase<BenchmarkCommand> {
         test_sizes_(std::move(test_sizes)),
         input_files_(std::move(input_files)),
         debug_(debug),
-        time_limit_ms_(time_limit_ms) {
+        time_limit_ms_(time_limit_ms),
+        granular_(granular),
+        granular_neighbors_(granular_neighbors),
+        granular_threshold_(granular_threshold) {
     if (verbose_) {
       std::cout << "Debug - Algorithm name: '" << algo_name_ << "'" << std::endl;
     }
@@ -49,6 +55,9 @@ class BenchmarkCommand : public CommandHandlerBase<BenchmarkCommand> {
   std::vector<std::string> input_files_;
   bool debug_;
   int time_limit_ms_;
+  bool granular_;              // Granular between-route reinsertion
+  int granular_neighbors_;     // Nearest zones a zone is inserted next to
+  double granular_threshold_;  // Neighbor distance cutoff, as a multiple of the mean
 };
 
 // Auto-register the command
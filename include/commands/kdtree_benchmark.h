@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "command_handler.h"
+#include "command_registry.h"
+
+namespace daa {
+
+/**
+ * Command handler for the KD-tree benchmark
+ * Compares the pointer-based GenericKDTree with the array-backed ImplicitKDTree on random points
+ */
+class KDTreeBenchmarkCommand : public CommandHandlerBase<KDTreeBenchmarkCommand> {
+ public:
+  KDTreeBenchmarkCommand(
+    std::vector<int> sizes,
+    int queries,
+    int k,
+    std::uint32_t seed,
+    bool verbose
+  )
+      : CommandHandlerBase(verbose),
+        sizes_(std::move(sizes)),
+        queries_(queries),
+        k_(k),
+        seed_(seed) {}
+
+  bool execute() override;
+
+  // Register this command with the registry
+  static void registerCommand(CommandRegistry& registry);
+
+ private:
+  std::vector<int> sizes_;
+  int queries_;
+  int k_;
+  std::uint32_t seed_;
+};
+
+// Auto-register the command
+REGISTER_COMMAND(KDTreeBenchmarkCommand);
+
+}  // namespace daa
@@ -40,6 +40,9 @@ concept SpeedConvertible = requires(T s) {
 
 enum class LocationType { DEPOT, COLLECTION_ZONE, SWTS, LANDFILL };
 
+// Number of LocationType values, for tables indexed by type
+inline constexpr size_t location_type_count = 4;
+
 template <typename T>
 concept LocationLike = requires(T l) {
   { l.id() } -> std::convertible_to<const std::string&>;
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "location.h"
+#include "strong_types.h"
+
+namespace daa {
+
+/**
+ * @brief Minimal allocator returning storage aligned to `Alignment` bytes
+ *
+ * Used for the matrix buffers so every row starts on a cache line boundary.
+ */
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+
+  template <typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  [[nodiscard]] T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+    return true;
+  }
+};
+
+/**
+ * @class DistanceMatrix
+ * @brief Flat matrix of pairwise distances and travel times indexed by LocationIndex
+ *
+ * In the full layout entries are stored row-major, so a lookup is a single indexed load. The
+ * symmetric layout stores only the upper triangle (diagonal included), packed column by column,
+ * which halves memory at the cost of ordering the pair before the load.
+ *
+ * Locations can be appended after construction. Packed columns simply extend the buffer; full
+ * rows keep spare columns (the stride exceeds the size) so only running out of them relays the
+ * matrix, which keeps appends amortized O(size).
+ */
+class DistanceMatrix {
+ public:
+  enum class Layout { Full, Symmetric };
+
+  DistanceMatrix() = default;
+
+  /**
+   * @brief Create a zero-filled matrix for `size` locations
+   * @param size Number of locations
+   * @param layout Storage layout
+   */
+  explicit DistanceMatrix(std::size_t size, Layout layout = Layout::Full)
+      : size_(size), stride_(size), layout_(layout) {
+    distances_.assign(entryCount(size, layout), 0.0);
+    travel_times_.assign(entryCount(size, layout), Duration{});
+  }
+
+  /**
+   * @brief Number of stored entries for a matrix of `size` locations
+   */
+  [[nodiscard]] static constexpr std::size_t entryCount(std::size_t size, Layout layout) noexcept {
+    return layout == Layout::Full ? size * size : size * (size + 1) / 2;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  // Distance between consecutive rows in the full layout
+  [[nodiscard]] std::size_t stride() const noexcept { return stride_; }
+  [[nodiscard]] Layout layout() const noexcept { return layout_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Memory used by the distance and travel time buffers, in bytes
+   */
+  [[nodiscard]] std::size_t memoryUsage() const noexcept {
+    return distances_.capacity() * sizeof(double) + travel_times_.capacity() * sizeof(Duration);
+  }
+
+  /**
+   * @brief Position of the (from, to) entry in the flat buffers
+   */
+  [[nodiscard]] std::size_t offset(LocationIndex from, LocationIndex to) const noexcept {
+    if (layout_ == Layout::Full) {
+      return static_cast<std::size_t>(from) * stride_ + to;
+    }
+    const std::size_t i = from < to ? from : to;
+    const std::size_t j = from < to ? to : from;
+    return j * (j + 1) / 2 + i;
+  }
+
+  [[nodiscard]] Distance distance(LocationIndex from, LocationIndex to) const {
+    return Distance{distances_[offset(from, to)]};
+  }
+
+  [[nodiscard]] Duration travelTime(LocationIndex from, LocationIndex to) const noexcept {
+    return travel_times_[offset(from, to)];
+  }
+
+  /**
+   * @brief Store the distance and travel time of a pair
+   *
+   * In the symmetric layout this also sets the (to, from) entry.
+   */
+  void set(LocationIndex from, LocationIndex to, double distance_meters, Duration travel_time) {
+    const std::size_t pos = offset(from, to);
+    distances_[pos] = distance_meters;
+    travel_times_[pos] = travel_time;
+  }
+
+  /**
+   * @brief Grow the matrix by one location
+   *
+   * The new row and column are zero-filled until set. In the full layout, running out of spare
+   * columns moves every row to a buffer with a quarter more of them.
+   */
+  void append() {
+    const std::size_t new_size = size_ + 1;
+
+    if (layout_ == Layout::Full && new_size > stride_) {
+      const std::size_t new_stride = std::max(new_size, stride_ + stride_ / 4);
+
+      decltype(distances_) distances;
+      decltype(travel_times_) travel_times;
+      distances.reserve(new_stride * new_stride);
+      travel_times.reserve(new_stride * new_stride);
+      distances.resize(size_ * new_stride, 0.0);
+      travel_times.resize(size_ * new_stride, Duration{});
+
+      for (std::size_t row = 0; row < size_; ++row) {
+        std::copy_n(
+          distances_.begin() + row * stride_, size_, distances.begin() + row * new_stride
+        );
+        std::copy_n(
+          travel_times_.begin() + row * stride_, size_, travel_times.begin() + row * new_stride
+        );
+      }
+
+      distances_ = std::move(distances);
+      travel_times_ = std::move(travel_times);
+      stride_ = new_stride;
+    }
+
+    const std::size_t entries = layout_ == Layout::Full ? new_size * stride_
+                                                        : entryCount(new_size, layout_);
+    distances_.resize(entries, 0.0);
+    travel_times_.resize(entries, Duration{});
+    size_ = new_size;
+  }
+
+  /**
+   * @brief Bounds-checked variant of travelTime()
+   * @throws std::out_of_range if either index is outside the matrix
+   */
+  [[nodiscard]] Duration travelTimeAt(LocationIndex from, LocationIndex to) const {
+    checkBounds(from, to);
+    return travelTime(from, to);
+  }
+
+  /**
+   * @brief Bounds-checked variant of distance()
+   * @throws std::out_of_range if either index is outside the matrix
+   */
+  [[nodiscard]] Distance distanceAt(LocationIndex from, LocationIndex to) const {
+    checkBounds(from, to);
+    return distance(from, to);
+  }
+
+  // Raw buffers, laid out according to layout(). Full rows are stride() entries apart.
+  [[nodiscard]] const double* distanceData() const noexcept { return distances_.data(); }
+  [[nodiscard]] double* distanceData() noexcept { return distances_.data(); }
+  [[nodiscard]] const Duration* travelTimeData() const noexcept { return travel_times_.data(); }
+  [[nodiscard]] Duration* travelTimeData() noexcept { return travel_times_.data(); }
+
+  void clear() noexcept {
+    size_ = 0;
+    stride_ = 0;
+    distances_.clear();
+    travel_times_.clear();
+  }
+
+ private:
+  std::size_t size_{0};
+  std::size_t stride_{0};
+  Layout layout_{Layout::Full};
+  std::vector<double, AlignedAllocator<double>> distances_;
+  std::vector<Duration, AlignedAllocator<Duration>> travel_times_;
+
+  void checkBounds(LocationIndex from, LocationIndex to) const {
+    if (from >= size_ || to >= size_) {
+      throw std::out_of_range(
+        "Matrix entry (" + std::to_string(from) + ", " + std::to_string(to) +
+        ") out of range for size " + std::to_string(size_)
+      );
+    }
+  }
+};
+
+}  // namespace daa
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "implicit_kdtree.h"
+
+namespace daa {
+
+/**
+ * @class DynamicKDTree
+ * @brief Insertable KD-tree built from static ImplicitKDTrees with the logarithmic method
+ *
+ * Points live in a forest where slot `i` holds a tree of at most 2^i points. An insert merges
+ * the new point with every tree in the run of occupied slots starting at slot 0 and builds one
+ * tree from them into the first free slot, like a carry in a binary counter. Each point is
+ * rebuilt O(log n) times over its lifetime at O(log n) per rebuild, so inserts cost amortized
+ * O(log² n). A query searches every tree, largest first, with a shared bound so the small trees
+ * are mostly pruned.
+ */
+template <std::totally_ordered IdType = std::uint32_t>
+class DynamicKDTree {
+ public:
+  using Tree = ImplicitKDTree<IdType>;
+  using Point = typename Tree::Point;
+  using Candidate = typename Tree::Candidate;
+
+  /**
+   * @brief Replace the contents with a single tree over `points`
+   */
+  void build(std::vector<Point> points) {
+    slots_.clear();
+    size_ = points.size();
+    if (points.empty()) {
+      return;
+    }
+
+    // Smallest slot whose capacity fits the points
+    slots_.resize(std::bit_width(points.size() - 1) + 1);
+    slots_.back().build(std::move(points));
+  }
+
+  /**
+   * @brief Add a point, rebuilding only the small trees it carries into
+   */
+  void insert(Point point) {
+    std::size_t slot = 0;
+    while (slot < slots_.size() && !slots_[slot].empty()) {
+      ++slot;
+    }
+    if (slot == slots_.size()) {
+      slots_.emplace_back();
+    }
+
+    // Slots below `slot` are all occupied and hold at most 2^slot - 1 points together
+    std::vector<Point> merged;
+    merged.reserve(std::size_t{1} << slot);
+    for (std::size_t i = 0; i < slot; ++i) {
+      slots_[i].appendPoints(merged);
+      slots_[i].clear();
+    }
+    merged.push_back(point);
+
+    slots_[slot].build(std::move(merged));
+    ++size_;
+  }
+
+  void clear() noexcept {
+    slots_.clear();
+    size_ = 0;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  // Number of non-empty trees in the forest
+  [[nodiscard]] std::size_t treeCount() const noexcept {
+    return static_cast<std::size_t>(
+      std::ranges::count_if(slots_, [](const Tree& tree) { return !tree.empty(); })
+    );
+  }
+
+  [[nodiscard]] std::size_t memoryUsage() const noexcept {
+    std::size_t bytes = 0;
+    for (const auto& tree : slots_) {
+      bytes += tree.memoryUsage();
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Find the nearest point accepted by the filter
+   * @return ID of the nearest accepted point, or nullopt if there is none
+   */
+  template <typename Filter = AcceptAllPoints>
+  requires std::predicate<const Filter&, IdType>
+  [[nodiscard]] std::optional<IdType> findNearest(double x, double y, const Filter& filter = {})
+    const {
+    std::optional<Candidate> best;
+    for (auto tree = slots_.rbegin(); tree != slots_.rend(); ++tree) {
+      tree->searchNearest(x, y, best, filter);
+    }
+    return best ? std::optional{best->second} : std::nullopt;
+  }
+
+  /**
+   * @brief Find the k nearest points accepted by the filter
+   * @return IDs of the accepted points, closest first
+   */
+  template <typename Filter = AcceptAllPoints>
+  requires std::predicate<const Filter&, IdType>
+  [[nodiscard]] std::vector<IdType>
+    findKNearest(double x, double y, std::size_t k, const Filter& filter = {}) const {
+    std::vector<Candidate> heap;
+    findKNearest(x, y, k, heap, filter);
+
+    std::vector<IdType> result;
+    result.reserve(heap.size());
+    for (const auto& [dist, id] : heap) {
+      result.push_back(id);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Find the k nearest points accepted by the filter into a caller-owned buffer
+   * @param out Receives (squared distance, ID) pairs, closest first
+   */
+  template <typename Filter = AcceptAllPoints>
+  requires std::predicate<const Filter&, IdType>
+  void findKNearest(
+    double x,
+    double y,
+    std::size_t k,
+    std::vector<Candidate>& out,
+    const Filter& filter = {}
+  ) const {
+    out.clear();
+    for (auto tree = slots_.rbegin(); tree != slots_.rend(); ++tree) {
+      tree->searchKNearest(x, y, k, out, filter);
+    }
+    std::ranges::sort_heap(out);
+  }
+
+ private:
+  std::vector<Tree> slots_;  // Slot i holds at most 2^i points
+  std::size_t size_{0};
+};
+
+}  // namespace daa
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace daa {
+
+// Default query filter, accepting every point
+struct AcceptAllPoints {
+  template <typename T>
+  [[nodiscard]] constexpr bool operator()(const T&) const noexcept {
+    return true;
+  }
+};
+
+/**
+ * @class ImplicitKDTree
+ * @brief Array-backed 2D KD-tree with bucketed leaves
+ *
+ * The tree is a complete binary tree stored in heap order: node `i` has children `2i + 1` and
+ * `2i + 2`, so no child pointers are kept. Every internal node halves its point range at the
+ * median of the axis with the larger spread, found with `nth_element`, which makes the build
+ * O(n log n). Points end up stored contiguously in leaf order as separate coordinate arrays, so
+ * a leaf bucket is scanned as a short linear run instead of a chain of heap nodes.
+ *
+ * Queries walk the tree iteratively with a fixed-size explicit stack and never allocate. Point
+ * ranges are not stored per node; they are recomputed on the way down from the same midpoint
+ * rule the build uses. Equidistant points resolve to the smallest ID, so results do not depend
+ * on the layout.
+ */
+template <std::totally_ordered IdType = std::uint32_t>
+class ImplicitKDTree {
+ public:
+  static constexpr std::size_t default_bucket_size = 8;
+
+  struct Point {
+    double x;
+    double y;
+    IdType id;
+  };
+
+  // Query result: squared distance to the query point, then ID. Ordering pairs
+  // lexicographically resolves equidistant points to the smallest ID.
+  using Candidate = std::pair<double, IdType>;
+
+  explicit ImplicitKDTree(std::size_t bucket_size = default_bucket_size)
+      : bucket_size_(std::max<std::size_t>(1, bucket_size)) {}
+
+  /**
+   * @brief Build the tree from a set of points, replacing the current contents
+   * @throws std::length_error if there are more points than a 32-bit range can address
+   */
+  void build(std::vector<Point> points) {
+    if (points.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("Too many points for an implicit KD-tree");
+    }
+
+    const std::size_t n = points.size();
+
+    // Smallest depth at which every leaf holds at most bucket_size_ points. Ranges split at
+    // their midpoint, so the largest leaf at depth d has ceil(n / 2^d) points.
+    depth_ = 0;
+    while (((n + (std::size_t{1} << depth_) - 1) >> depth_) > bucket_size_) {
+      ++depth_;
+    }
+
+    const std::size_t internal_count = (std::size_t{1} << depth_) - 1;
+    splits_.assign(internal_count, 0.0);
+    axes_.assign(internal_count, 0);
+
+    if (n > 0) {
+      buildNode(points, 0, 0, n);
+    }
+
+    xs_.resize(n);
+    ys_.resize(n);
+    ids_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      xs_[i] = points[i].x;
+      ys_[i] = points[i].y;
+      ids_[i] = points[i].id;
+    }
+  }
+
+  void clear() noexcept {
+    xs_.clear();
+    ys_.clear();
+    ids_.clear();
+    splits_.clear();
+    axes_.clear();
+    depth_ = 0;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return ids_.empty(); }
+  [[nodiscard]] std::size_t size() const noexcept { return ids_.size(); }
+  [[nodiscard]] std::size_t bucketSize() const noexcept { return bucket_size_; }
+
+  // Append the stored points, in leaf order
+  void appendPoints(std::vector<Point>& out) const {
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+      out.push_back({xs_[i], ys_[i], ids_[i]});
+    }
+  }
+
+  [[nodiscard]] std::span<const IdType> ids() const noexcept { return ids_; }
+
+  [[nodiscard]] std::size_t memoryUsage() const noexcept {
+    return (xs_.capacity() + ys_.capacity() + splits_.capacity()) * sizeof(double) +
+           ids_.capacity() * sizeof(IdType) + axes_.capacity() * sizeof(std::uint8_t);
+  }
+
+  /**
+   * @brief Find the nearest point accepted by the filter
+   * @param x Query X coordinate
+   * @param y Query Y coordinate
+   * @param filter Predicate over point IDs
+   * @return ID of the nearest accepted point, or nullopt if there is none
+   */
+  template <typename Filter = AcceptAllPoints>
+  requires std::predicate<const Filter&, IdType>
+  [[nodiscard]] std::optional<IdType> findNearest(double x, double y, const Filter& filter = {})
+    const {
+    std::optional<Candidate> best;
+    searchNearest(x, y, best, filter);
+    return best ? std::optional{best->second} : std::nullopt;
+  }
+
+  /**
+   * @brief Find the k nearest points accepted by the filter
+   * @return IDs of the accepted points, closest first
+   */
+  template <typename Filter = AcceptAllPoints>
+  requires std::predicate<const Filter&, IdType>
+  [[nodiscard]] std::vector<IdType>
+    findKNearest(double x, double y, std::size_t k, const Filter& filter = {}) const {
+    std::vector<Candidate> heap;
+    findKNearest(x, y, k, heap, filter);
+
+    std::vector<IdType> result;
+    result.reserve(heap.size());
+    for (const auto& [dist, id] : heap) {
+      result.push_back(id);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Find the k nearest points accepted by the filter into a caller-owned buffer
+   * @param out Receives (squared distance, ID) pairs, closest first. Reusing the buffer across
+   *            queries keeps them allocation-free.
+   */
+  template <typename Filter = AcceptAllPoints>
+  requires std::predicate<const Filter&, IdType>
+  void findKNearest(
+    double x,
+    double y,
+    std::size_t k,
+    std::vector<Candidate>& out,
+    const Filter& filter = {}
+  ) const {
+    out.clear();
+    searchKNearest(x, y, k, out, filter);
+    std::ranges::sort_heap(out);
+  }
+
+  /**
+   * @brief Improve a running nearest-neighbor result with the points of this tree
+   *
+   * Lets several trees answer one query: each search prunes against the best candidate the
+   * previous ones found.
+   */
+  template <typename Filter>
+  requires std::predicate<const Filter&, IdType>
+  void searchNearest(double x, double y, std::optional<Candidate>& best, const Filter& filter)
+    const {
+    auto bound = [&]() { return best ? best->first : std::numeric_limits<double>::infinity(); };
+
+    visit(x, y, bound, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const Candidate candidate{squaredDistance(x, y, i), ids_[i]};
+        if ((!best || candidate < *best) && filter(ids_[i])) {
+          best = candidate;
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Improve a running k-nearest result with the points of this tree
+   * @param heap Max-heap of at most k candidates, worst on top, shared across trees
+   */
+  template <typename Filter>
+  requires std::predicate<const Filter&, IdType>
+  void searchKNearest(
+    double x,
+    double y,
+    std::size_t k,
+    std::vector<Candidate>& heap,
+    const Filter& filter
+  ) const {
+    if (k == 0) {
+      return;
+    }
+
+    auto bound = [&]() {
+      return heap.size() < k ? std::numeric_limits<double>::infinity() : heap.front().first;
+    };
+
+    visit(x, y, bound, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const Candidate candidate{squaredDistance(x, y, i), ids_[i]};
+        if (heap.size() == k && !(candidate < heap.front())) {
+          continue;
+        }
+        if (!filter(ids_[i])) {
+          continue;
+        }
+        if (heap.size() == k) {
+          std::ranges::pop_heap(heap);
+          heap.back() = candidate;
+        } else {
+          heap.push_back(candidate);
+        }
+        std::ranges::push_heap(heap);
+      }
+    });
+  }
+
+ private:
+  // A 32-bit point range cannot produce a deeper tree, so this bounds the query stack
+  static constexpr std::size_t max_depth = 32;
+
+  struct StackEntry {
+    std::size_t node;
+    std::uint32_t begin;
+    std::uint32_t end;
+    std::array<double, 2> offsets;  // Squared per-axis distance from the query to the cell
+    double bound;                   // Their sum, a lower bound on any distance in the cell
+  };
+
+  std::size_t bucket_size_;
+  std::size_t depth_{0};
+
+  // Per internal node, in heap order
+  std::vector<double> splits_;
+  std::vector<std::uint8_t> axes_;
+
+  // Points in leaf order
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<IdType> ids_;
+
+  [[nodiscard]] double squaredDistance(double x, double y, std::size_t i) const noexcept {
+    const double dx = x - xs_[i];
+    const double dy = y - ys_[i];
+    return dx * dx + dy * dy;
+  }
+
+  [[nodiscard]] bool isLeaf(std::size_t node) const noexcept { return node >= splits_.size(); }
+
+  void buildNode(std::vector<Point>& points, std::size_t node, std::size_t begin, std::size_t end) {
+    if (isLeaf(node)) {
+      return;
+    }
+
+    const auto range = std::span{points}.subspan(begin, end - begin);
+
+    // Split on the axis along which the range is most spread out
+    auto [min_x, max_x] = std::ranges::minmax(range | std::views::transform(&Point::x));
+    auto [min_y, max_y] = std::ranges::minmax(range | std::views::transform(&Point::y));
+    const std::uint8_t axis = (max_y - min_y) > (max_x - min_x) ? 1 : 0;
+
+    const std::size_t mid = begin + (end - begin) / 2;
+    const auto key = axis == 0 ? &Point::x : &Point::y;
+    std::ranges::nth_element(range, range.begin() + (mid - begin), {}, key);
+
+    axes_[node] = axis;
+    splits_[node] = points[mid].*key;
+
+    buildNode(points, 2 * node + 1, begin, mid);
+    buildNode(points, 2 * node + 2, mid, end);
+  }
+
+  /**
+   * @brief Depth-first traversal visiting leaves whose cell may beat the current bound
+   *
+   * The near child is always visited first. `bound()` returns the squared distance a cell must
+   * not exceed to be worth visiting; `scan(begin, end)` processes a leaf's point range.
+   */
+  template <typename Bound, typename Scan>
+  void visit(double x, double y, const Bound& bound, const Scan& scan) const {
+    if (ids_.empty()) {
+      return;
+    }
+
+    std::array<StackEntry, max_depth + 1> stack;
+    std::size_t top = 0;
+    stack[top++] = {0, 0, static_cast<std::uint32_t>(ids_.size()), {0.0, 0.0}, 0.0};
+
+    while (top > 0) {
+      StackEntry entry = stack[--top];
+      if (entry.bound > bound()) {
+        continue;
+      }
+
+      // Walk down to the leaf containing the query, deferring the far children. The near child
+      // shares its parent's cell distance, so only the far one needs its bound updated.
+      while (!isLeaf(entry.node)) {
+        const std::size_t axis = axes_[entry.node];
+        const std::uint32_t mid = entry.begin + (entry.end - entry.begin) / 2;
+        const double delta = (axis == 0 ? x : y) - splits_[entry.node];
+
+        StackEntry near = entry;
+        StackEntry far = entry;
+        if (delta < 0.0) {
+          near.node = 2 * entry.node + 1;
+          near.end = mid;
+          far.node = 2 * entry.node + 2;
+          far.begin = mid;
+        } else {
+          near.node = 2 * entry.node + 2;
+          near.begin = mid;
+          far.node = 2 * entry.node + 1;
+          far.end = mid;
+        }
+
+        far.offsets[axis] = delta * delta;
+        far.bound = far.offsets[0] + far.offsets[1];
+        if (far.bound <= bound()) {
+          stack[top++] = far;
+        }
+
+        entry = near;
+      }
+
+      scan(entry.begin, entry.end);
+    }
+  }
+};
+
+}  // namespace daa
@@ -1,18 +1,21 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <concepts>
 #include <cmath>
-#include <functional>
+#include <deque>
 #include <limits>
 #include <memory>
 #include <optional>
-#include <ranges>
 #include <span>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 #include "concepts.h"
+#include "dynamic_kdtree.h"
 #include "location.h"
+#include "neighbor_lists.h"
 #include "strong_types.h"
 
 namespace daa {
@@ -96,6 +99,11 @@ requires KDTreePoint<PointType> class GenericKDTree {
     PointContainer(PointType p, IdType i) : point(std::move(p)), id(std::move(i)) {}
   };
 
+  // Query filters are any callable taking a stored point. They are passed by template so the
+  // predicate is inlined into the search instead of going through a type-erased wrapper.
+  template <typename F>
+  static constexpr bool is_filter = std::predicate<const F&, const PointContainer&>;
+
  private:
   struct Node {
     PointContainer data;
@@ -105,9 +113,19 @@ requires KDTreePoint<PointType> class GenericKDTree {
     explicit Node(PointContainer pc) : data(std::move(pc)) {}
   };
 
+  // Keeps the farthest of the k candidates at the top of the heap
+  struct FartherFirst {
+    bool operator()(
+      const std::pair<const PointContainer*, double>& a,
+      const std::pair<const PointContainer*, double>& b
+    ) const noexcept {
+      return a.second < b.second;
+    }
+  };
+
   std::unique_ptr<Node> root_;
   size_t dimensions_{0};
-  std::unordered_map<IdType, std::unordered_map<IdType, double>> distance_cache_;
+  size_t size_{0};
   DistanceCalculator distance_calculator_{};
 
   // Helper function to build the tree recursively
@@ -137,12 +155,13 @@ requires KDTreePoint<PointType> class GenericKDTree {
   }
 
   // Recursive nearest neighbor search
+  template <typename Filter>
   void findNearestRecursive(
     const Node* node,
     const PointType& target,
-    std::function<bool(const PointType&)> filter,
+    const Filter& filter,
     size_t depth,
-    std::optional<PointContainer>& best,
+    const PointContainer*& best,
     double& best_dist
   ) const {
     if (!node) {
@@ -151,8 +170,11 @@ requires KDTreePoint<PointType> class GenericKDTree {
 
     const double dist = distance_calculator_.calculate(node->data.point, target);
 
-    if ((!best || dist < best_dist) && (!filter || filter(node->data.point))) {
-      best = node->data;
+    // Equidistant points resolve to the smallest ID, so the result does not depend on tree shape
+    const bool closer =
+      !best || dist < best_dist || (dist == best_dist && node->data.id < best->id);
+    if (closer && filter(node->data)) {
+      best = &node->data;
       best_dist = dist;
     }
 
@@ -169,19 +191,20 @@ requires KDTreePoint<PointType> class GenericKDTree {
     // Search first subtree
     findNearestRecursive(first, target, filter, depth + 1, best, best_dist);
 
-    // Only search second subtree if it could contain a closer point
-    if (axis_dist < best_dist) {
+    // Only search second subtree if it could contain a closer (or equally close) point
+    if (axis_dist <= best_dist) {
       findNearestRecursive(second, target, filter, depth + 1, best, best_dist);
     }
   }
 
   // Helper function for k-nearest neighbors search
+  template <typename Filter>
   void findKNearestRecursive(
     const Node* node,
     const PointType& target,
-    std::function<bool(const PointType&)> filter,
+    const Filter& filter,
     size_t k,
-    std::vector<std::pair<PointContainer, double>>& result,
+    std::vector<std::pair<const PointContainer*, double>>& result,
     size_t depth
   ) const {
     if (!node)
@@ -189,23 +212,15 @@ requires KDTreePoint<PointType> class GenericKDTree {
 
     const double dist = distance_calculator_.calculate(node->data.point, target);
 
-    // If the point passes the filter (or no filter), consider it
-    if (!filter || filter(node->data.point)) {
+    // If the point passes the filter, consider it
+    if (filter(node->data)) {
       if (result.size() < k) {
-        result.emplace_back(node->data, dist);
-        std::push_heap(result.begin(), result.end(), [](const auto& a, const auto& b) {
-          return a.second < b.second;
-        });
+        result.emplace_back(&node->data, dist);
+        std::ranges::push_heap(result, FartherFirst{});
       } else if (dist < result.front().second) {
-        // Modified approach that avoids direct assignment
-        std::pop_heap(result.begin(), result.end(), [](const auto& a, const auto& b) {
-          return a.second < b.second;
-        });
-        result.pop_back();                      // Remove the element that was moved to the back
-        result.emplace_back(node->data, dist);  // Add new element
-        std::push_heap(result.begin(), result.end(), [](const auto& a, const auto& b) {
-          return a.second < b.second;
-        });
+        std::ranges::pop_heap(result, FartherFirst{});
+        result.back() = {&node->data, dist};
+        std::ranges::push_heap(result, FartherFirst{});
       }
     }
 
@@ -247,39 +262,6 @@ requires KDTreePoint<PointType> class GenericKDTree {
     collectIds(node->right.get(), result);
   }
 
-  // Find a point by ID
-  [[nodiscard]] PointContainer findPoint(const IdType& id) const {
-    std::optional<PointContainer> result;
-    findPointByIdRecursive(root_.get(), id, result);
-
-    if (!result) {
-      throw std::out_of_range("Point with ID not found: " + std::string(id));
-    }
-
-    return *result;
-  }
-
-  // Recursively search for a point by ID
-  void findPointByIdRecursive(
-    const Node* node,
-    const IdType& id,
-    std::optional<PointContainer>& result
-  ) const {
-    if (!node)
-      return;
-
-    if (node->data.id == id) {
-      result = node->data;
-      return;
-    }
-
-    findPointByIdRecursive(node->left.get(), id, result);
-    if (result)
-      return;
-
-    findPointByIdRecursive(node->right.get(), id, result);
-  }
-
  public:
   GenericKDTree() = default;
 
@@ -290,32 +272,18 @@ requires KDTreePoint<PointType> class GenericKDTree {
     }
 
     dimensions_ = point_containers.front().point.dimensions();
-
-    // Pre-compute all pairwise distances for efficient lookup
-    for (const auto& pc1 : point_containers) {
-      for (const auto& pc2 : point_containers) {
-        if (pc1.id == pc2.id) {
-          distance_cache_[pc1.id][pc2.id] = 0.0;
-        } else {
-          const double dist = distance_calculator_.calculate(pc1.point, pc2.point);
-          distance_cache_[pc1.id][pc2.id] = dist;
-        }
-      }
-    }
+    size_ = point_containers.size();
 
     root_ = buildTreeRecursive(std::span{point_containers}, 0);
   }
 
-  // Find nearest neighbor with optional filter
-  [[nodiscard]] std::optional<PointContainer> findNearest(
-    const PointType& target,
-    std::function<bool(const PointType&)> filter = nullptr
-  ) const {
-    if (!root_) {
-      return std::nullopt;
-    }
-
-    std::optional<PointContainer> best;
+  // Find nearest neighbor accepted by the filter. The result points into the tree and stays
+  // valid until the tree is modified.
+  template <typename Filter = AcceptAllPoints>
+  requires is_filter<Filter>
+  [[nodiscard]] const PointContainer*
+    findNearest(const PointType& target, const Filter& filter = {}) const {
+    const PointContainer* best = nullptr;
     double best_dist = std::numeric_limits<double>::max();
 
     findNearestRecursive(root_.get(), target, filter, 0, best, best_dist);
@@ -323,50 +291,44 @@ requires KDTreePoint<PointType> class GenericKDTree {
     return best;
   }
 
-  // Find k nearest neighbors with optional filter
-  [[nodiscard]] std::vector<PointContainer> findKNearest(
-    const PointType& target,
-    size_t k,
-    std::function<bool(const PointType&)> filter = nullptr
-  ) const {
+  // Find the k nearest neighbors accepted by the filter, closest first. Results point into the
+  // tree and stay valid until the tree is modified.
+  template <typename Filter = AcceptAllPoints>
+  requires is_filter<Filter>
+  [[nodiscard]] std::vector<const PointContainer*>
+    findKNearest(const PointType& target, size_t k, const Filter& filter = {}) const {
     if (!root_ || k == 0) {
       return {};
     }
 
-    std::vector<std::pair<PointContainer, double>> nearest;
-    nearest.reserve(k);
+    std::vector<std::pair<const PointContainer*, double>> nearest;
+    nearest.reserve(std::min(k, size_));
 
     findKNearestRecursive(root_.get(), target, filter, k, nearest, 0);
+    std::ranges::sort_heap(nearest, FartherFirst{});
 
-    std::vector<PointContainer> result;
+    std::vector<const PointContainer*> result;
     result.reserve(nearest.size());
-
-    std::ranges::transform(nearest, std::back_inserter(result), [](const auto& pair) {
-      return pair.first;
-    });
+    for (const auto& [container, dist] : nearest) {
+      result.push_back(container);
+    }
 
     return result;
   }
 
-  // Get cached distance between two points
-  [[nodiscard]] double getDistance(const IdType& id1, const IdType& id2) const {
-    try {
-      return distance_cache_.at(id1).at(id2);
-    } catch (const std::out_of_range&) {
-      throw std::out_of_range("Distance not found in cache");
-    }
-  }
-
-  // Clear the tree and cache
+  // Clear the tree
   void clear() {
     root_.reset();
-    distance_cache_.clear();
     dimensions_ = 0;
+    size_ = 0;
   }
 
   // Check if tree is empty
   [[nodiscard]] bool empty() const noexcept { return !root_; }
 
+  // Number of stored points
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+
   // Get all IDs in the tree
   [[nodiscard]] std::vector<IdType> getAllIds() const {
     std::vector<IdType> result;
@@ -376,22 +338,7 @@ requires KDTreePoint<PointType> class GenericKDTree {
 
   // Insert a new point into the tree
   void insert(PointContainer new_point) {
-    // Get all existing point IDs
-    auto existing_ids = getAllIds();
-
-    // Update distance cache for new point
-    for (const auto& id : existing_ids) {
-      if (new_point.id != id) {
-        // Calculate distances between the new point and all existing points
-        double dist = distance_calculator_.calculate(new_point.point, findPoint(id).point);
-
-        distance_cache_[new_point.id][id] = dist;
-        distance_cache_[id][new_point.id] = dist;
-      }
-    }
-
-    // Self distance is always 0
-    distance_cache_[new_point.id][new_point.id] = 0.0;
+    ++size_;
 
     // If tree is empty, create root
     if (!root_) {
@@ -402,7 +349,6 @@ requires KDTreePoint<PointType> class GenericKDTree {
 
     // Insert the point maintaining tree balance
     std::vector<PointContainer> all_points;
-    all_points.reserve(existing_ids.size() + 1);
 
     // Collect existing points
     collectPoints(root_.get(), all_points);
@@ -415,214 +361,183 @@ requires KDTreePoint<PointType> class GenericKDTree {
   }
 };
 
-// Specialized KDTree for Locations
+/**
+ * @class KDTree
+ * @brief Spatial index over the problem locations, partitioned by LocationType
+ *
+ * Each location type has its own DynamicKDTree, so a query for the nearest SWTS only visits
+ * SWTS points instead of walking past every collection zone and rejecting it, and locations
+ * added after the build are inserted in amortized O(log² n). Queries return location indices;
+ * the locations themselves are owned here and can be looked up with getLocation().
+ */
 class KDTree {
  private:
-  GenericKDTree<LocationAdapter, EuclideanDistanceCalculator<LocationAdapter>> tree_;
-  std::unordered_map<std::string, Location> locations_;
-  std::unordered_map<std::string, std::unordered_map<std::string, Duration>> time_matrix_;
-
-  // Calculate travel time based on distance
-  [[nodiscard]] static Duration calculateTime(double distance_meters) noexcept {
-    constexpr double average_speed = 50.0;  // km/h
-    return Duration{
-      (distance_meters * units::meters_to_kilometers / average_speed) * 60.0,
-      units::TimeUnit::Minutes
-    };
-  }
+  using Tree = DynamicKDTree<LocationIndex>;
 
- public:
-  // Build KDTree from locations
-  void build(std::vector<Location> locations) {
-    if (locations.empty()) {
-      throw std::invalid_argument("Cannot build tree with empty locations");
-    }
+  std::array<Tree, location_type_count> trees_;
+  // Indexed by LocationIndex. A deque keeps references handed out by getLocation() valid when
+  // locations are inserted.
+  std::deque<Location> locations_;
 
-    locations_.clear();
-    time_matrix_.clear();
+  [[nodiscard]] Tree& treeFor(LocationType type) noexcept {
+    return trees_[static_cast<size_t>(type)];
+  }
 
-    // First store locations in map using ranges
-    locations_ =
-      locations |
-      std::ranges::views::transform([](const auto& loc) { return std::pair{loc.id(), loc}; }) |
-      std::ranges::to<std::unordered_map<std::string, Location>>();
+  [[nodiscard]] const Tree& treeFor(LocationType type) const noexcept {
+    return trees_[static_cast<size_t>(type)];
+  }
 
-    // Then create adapters that reference the stored locations
-    auto point_containers =
-      locations_ | std::ranges::views::transform([](const auto& pair) {
-        const auto& [id, loc] = pair;
-        return typename GenericKDTree<LocationAdapter>::PointContainer{LocationAdapter(loc), id};
-      }) |
-      std::ranges::to<std::vector>();
+  // Locations must carry the dense index matching their position in the tree
+  void checkIndex(const Location& location, size_t expected) const {
+    if (location.index() != expected) {
+      throw std::invalid_argument(
+        "Location " + location.id() + " has index " + std::to_string(location.index()) +
+        ", expected " + std::to_string(expected)
+      );
+    }
+  }
 
-    tree_.build(std::move(point_containers));
+  // Rebuild every per-type tree from the stored locations
+  void rebuildTrees() {
+    std::array<std::vector<Tree::Point>, location_type_count> partitions;
+    for (const auto& location : locations_) {
+      partitions[static_cast<size_t>(location.type())].push_back(
+        {location.x(), location.y(), location.index()}
+      );
+    }
 
-    // Pre-calculate time matrix using modern C++ techniques
-    const auto location_ids =
-      locations_ | std::ranges::views::keys | std::ranges::to<std::vector>();
+    for (size_t type = 0; type < location_type_count; ++type) {
+      trees_[type].build(std::move(partitions[type]));
+    }
+  }
 
-    // Reserve space in time matrix for better performance
-    for (const auto& id : location_ids) {
-      time_matrix_[id].reserve(location_ids.size());
+ public:
+  // Build KDTree from locations, indexed by their LocationIndex
+  void build(std::vector<Location> locations) {
+    if (locations.empty()) {
+      throw std::invalid_argument("Cannot build tree with empty locations");
     }
 
-    // Fill time matrix using ranges for clearer expression of intent
-    for (const auto& id1 : location_ids) {
-      auto& id1_map = time_matrix_[id1];
+    for (size_t i = 0; i < locations.size(); ++i) {
+      checkIndex(locations[i], i);
+    }
 
-      // Self-distance is always 0
-      id1_map[id1] = Duration{0.0};
+    locations_.assign(
+      std::make_move_iterator(locations.begin()), std::make_move_iterator(locations.end())
+    );
 
-      // Calculate other distances using ranges
-      auto other_ids =
-        location_ids | std::ranges::views::filter([&id1](const auto& id) { return id != id1; });
+    rebuildTrees();
+  }
 
-      for (const auto& id2 : other_ids) {
-        const double dist = tree_.getDistance(id1, id2);
-        id1_map[id2] = calculateTime(dist);
-      }
-    }
+  /**
+   * @brief Find the nearest location of a type that also passes a filter
+   * @param from Query position
+   * @param target_type Type of location to search
+   * @param filter Predicate over candidate location indices
+   * @return Index of the nearest accepted location, or nullopt if there is none
+   */
+  template <std::predicate<LocationIndex> Filter>
+  [[nodiscard]] std::optional<LocationIndex>
+    findNearest(const Location& from, LocationType target_type, const Filter& filter) const {
+    return treeFor(target_type).findNearest(from.x(), from.y(), filter);
   }
 
   // Find nearest location of a specific type
-  [[nodiscard]] std::optional<Location> findNearest(const Location& from, LocationType target_type)
-    const {
-    const LocationAdapter adapter(from);
-
-    auto result = tree_.findNearest(adapter, [target_type](const LocationAdapter& adapter) {
-      return adapter.getLocation().type() == target_type;
-    });
+  [[nodiscard]] std::optional<LocationIndex>
+    findNearest(const Location& from, LocationType target_type) const {
+    return treeFor(target_type).findNearest(from.x(), from.y());
+  }
 
-    if (result) {
-      return locations_.at(result->id);
-    }
+  // Find nearest location of a specific type to a stored location
+  [[nodiscard]] std::optional<LocationIndex>
+    findNearest(LocationIndex from, LocationType target_type) const {
+    return findNearest(locations_.at(from), target_type);
+  }
 
-    return std::nullopt;
+  /**
+   * @brief Find the k nearest locations of a type that also pass a filter
+   * @return Indices of the accepted locations, closest first
+   */
+  template <std::predicate<LocationIndex> Filter>
+  [[nodiscard]] std::vector<LocationIndex> findKNearest(
+    const Location& from,
+    LocationType target_type,
+    size_t k,
+    const Filter& filter
+  ) const {
+    return treeFor(target_type).findKNearest(from.x(), from.y(), k, filter);
   }
 
-  // Find k nearest locations of a specific type
-  [[nodiscard]] std::vector<Location>
+  // Find k nearest locations of a specific type, closest first
+  [[nodiscard]] std::vector<LocationIndex>
     findKNearest(const Location& from, LocationType target_type, size_t k) const {
+    return treeFor(target_type).findKNearest(from.x(), from.y(), k);
+  }
+
+  // Find the k nearest locations of any type to a stored location, excluding itself. Results
+  // are unordered and gathered from every per-type tree, so they may hold more than k entries;
+  // the caller keeps the closest.
+  [[nodiscard]] std::vector<LocationIndex> findKNearestIndices(LocationIndex from, size_t k) const {
     if (k == 0)
       return {};
 
-    const LocationAdapter adapter(from);
-
-    auto results = tree_.findKNearest(adapter, k, [target_type](const LocationAdapter& adapter) {
-      return adapter.getLocation().type() == target_type;
-    });
+    const Location& location = locations_.at(from);
 
-    // Use ranges to transform results to locations
-    return results | std::ranges::views::transform([this](const auto& result) {
-             return locations_.at(result.id);
-           }) |
-           std::ranges::to<std::vector>();
-  }
+    std::vector<LocationIndex> indices;
+    for (const auto& tree : trees_) {
+      for (const auto index : tree.findKNearest(location.x(), location.y(), k + 1)) {
+        if (index != from) {
+          indices.push_back(index);
+        }
+      }
+    }
 
-  // Get distance between two locations
-  [[nodiscard]] Distance getDistance(const std::string& from_id, const std::string& to_id) const {
-    const double dist = tree_.getDistance(from_id, to_id);
-    return Distance{dist};
+    return indices;
   }
 
-  // Get travel time between two locations
-  [[nodiscard]] Duration getTravelTime(const std::string& from_id, const std::string& to_id) const {
-    return time_matrix_.at(from_id).at(to_id);
-  }
+  /**
+   * @brief Find the k nearest locations of a type for every stored location
+   *
+   * Rows are computed in parallel and exclude the location itself. Distances are computed with
+   * MatrixBuilder::distance, so they match the distance matrix exactly.
+   * @param target_type Type of the neighbors
+   * @param k Neighbors per location
+   * @param threads Worker threads, 0 uses the hardware concurrency
+   * @return One row per LocationIndex, closest first
+   */
+  [[nodiscard]] NeighborLists
+    findKNearestAll(LocationType target_type, size_t k, unsigned int threads = 0) const;
 
   // Check if the tree contains locations
-  [[nodiscard]] bool empty() const noexcept { return tree_.empty(); }
+  [[nodiscard]] bool empty() const noexcept { return locations_.empty(); }
 
-  // Get all locations
-  [[nodiscard]] const std::unordered_map<std::string, Location>& getLocations() const noexcept {
-    return locations_;
-  }
+  // Number of stored locations
+  [[nodiscard]] size_t size() const noexcept { return locations_.size(); }
 
-  // Insert a new location into the tree
-  void insert(Location location) {
-    const std::string id = location.id();
+  // Number of stored locations of one type
+  [[nodiscard]] size_t size(LocationType type) const noexcept { return treeFor(type).size(); }
 
-    // Store the new location
-    locations_[id] = std::move(location);
+  // Get a location by index
+  [[nodiscard]] const Location& getLocation(LocationIndex index) const {
+    return locations_.at(index);
+  }
 
-    // Create a point container for the new location
-    const LocationAdapter adapter(locations_.at(id));
-    typename GenericKDTree<LocationAdapter>::PointContainer point_container{adapter, id};
+  // Get all locations, ordered by index
+  [[nodiscard]] const std::deque<Location>& getLocations() const noexcept { return locations_; }
 
-    // Insert into the tree
-    tree_.insert(std::move(point_container));
+  // Insert a new location into the tree. Its index must be the next free one.
+  void insert(Location location) {
+    checkIndex(location, locations_.size());
 
-    // Update time matrix with the new location
-    updateTimeMatrixForLocation(id);
+    // Insert into the tree for its type
+    treeFor(location.type()).insert({location.x(), location.y(), location.index()});
+    locations_.push_back(std::move(location));
   }
 
   // Batch insert multiple locations
   void insertBatch(std::vector<Location> locations) {
-    if (locations.empty())
-      return;
-
-    // Store all new locations
     for (auto& location : locations) {
-      const std::string id = location.id();
-      locations_[id] = std::move(location);
-    }
-
-    // Rebuild the tree with all locations
-    auto point_containers =
-      locations_ | std::ranges::views::transform([](const auto& pair) {
-        const auto& [id, loc] = pair;
-        return typename GenericKDTree<LocationAdapter>::PointContainer{LocationAdapter(loc), id};
-      }) |
-      std::ranges::to<std::vector>();
-
-    tree_.build(std::move(point_containers));
-
-    // Rebuild the time matrix
-    rebuildTimeMatrix();
-  }
-
- private:
-  // Update time matrix for a newly added location
-  void updateTimeMatrixForLocation(const std::string& id) {
-    // Ensure the location's self-distance is 0
-    time_matrix_[id][id] = Duration{0.0};
-
-    // Calculate travel times between the new location and all existing locations
-    for (const auto& [other_id, _] : locations_) {
-      if (other_id != id) {
-        const double dist = tree_.getDistance(id, other_id);
-        const auto travel_time = calculateTime(dist);
-
-        // Update both directions
-        time_matrix_[id][other_id] = travel_time;
-        time_matrix_[other_id][id] = travel_time;
-      }
-    }
-  }
-
-  // Completely rebuild the time matrix
-  void rebuildTimeMatrix() {
-    time_matrix_.clear();
-
-    // Get all location IDs
-    const auto ids = locations_ | std::ranges::views::keys | std::ranges::to<std::vector>();
-
-    // Pre-reserve space for efficiency
-    for (const auto& id : ids) {
-      time_matrix_[id].reserve(ids.size());
-    }
-
-    // Populate the time matrix
-    for (const auto& id1 : ids) {
-      // Set self-travel time to 0
-      time_matrix_[id1][id1] = Duration{0.0};
-
-      // Calculate times to other locations
-      for (const auto& id2 :
-           ids | std::ranges::views::filter([&id1](const auto& id) { return id != id1; })) {
-        const double dist = tree_.getDistance(id1, id2);
-        time_matrix_[id1][id2] = calculateTime(dist);
-      }
+      insert(std::move(location));
     }
   }
 };
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "distance_matrix.h"
+#include "kdtree.h"
+#include "location.h"
+#include "matrix_builder.h"
+#include "strong_types.h"
+
+namespace daa {
+
+/**
+ * @brief How VRPTProblem answers distance and travel time queries
+ */
+enum class DistanceMode {
+  Auto,   // Dense if the matrix fits in the memory budget, lazy otherwise
+  Dense,  // Precomputed DistanceMatrix
+  Lazy    // Computed on demand, with a cached neighbor list per location
+};
+
+/**
+ * @brief Options controlling how distances are stored when a problem is loaded
+ */
+struct DistanceOptions {
+  DistanceMode mode{DistanceMode::Auto};
+  DistanceMatrix::Layout layout{DistanceMatrix::Layout::Full};
+  std::size_t memory_budget{std::size_t{1} << 30};  // Bytes a dense matrix may use in Auto mode
+  std::size_t neighbor_count{16};                   // Neighbors cached per location in lazy mode
+};
+
+/**
+ * @class LazyDistanceProvider
+ * @brief Distance and travel time source for instances too large for an N² matrix
+ *
+ * Values are computed from the coordinates on demand with the same arithmetic as MatrixBuilder,
+ * so both modes return identical results. The k nearest neighbors of every location, which are
+ * the pairs the solvers query most, are found with the KD-tree at build time and cached with
+ * their distances and times in fixed-size rows.
+ */
+class LazyDistanceProvider {
+ public:
+  LazyDistanceProvider() = default;
+
+  /**
+   * @brief Copy the coordinates and build the neighbor cache
+   * @param xs X coordinates in meters, indexed by LocationIndex
+   * @param ys Y coordinates in meters, indexed by LocationIndex
+   * @param tree Spatial index over the same locations
+   * @param neighbor_count Neighbors to cache per location
+   * @param speed_kmh Average speed used to derive travel times
+   */
+  void build(
+    std::span<const double> xs,
+    std::span<const double> ys,
+    const KDTree& tree,
+    std::size_t neighbor_count,
+    double speed_kmh = default_travel_speed_kmh
+  ) {
+    xs_.assign(xs.begin(), xs.end());
+    ys_.assign(ys.begin(), ys.end());
+    speed_kmh_ = speed_kmh;
+
+    const std::size_t n = xs_.size();
+    k_ = n > 0 ? std::min(neighbor_count, n - 1) : 0;
+
+    neighbor_ids_.assign(n * k_, invalid_location_index);
+    neighbor_distances_.assign(n * k_, 0.0);
+    neighbor_times_.assign(n * k_, Duration{});
+
+    std::vector<std::pair<double, LocationIndex>> candidates;
+    for (LocationIndex from = 0; from < n && k_ > 0; ++from) {
+      fillNeighbors(from, tree, candidates);
+    }
+  }
+
+  /**
+   * @brief Add a location after the build
+   *
+   * Caches the neighbors of the new location and inserts it into the rows of existing
+   * locations it is now among the closest of. The neighbor count is kept from the build.
+   * @param x X coordinate in meters
+   * @param y Y coordinate in meters
+   * @param tree Spatial index that already contains the new location
+   */
+  void append(double x, double y, const KDTree& tree) {
+    const auto index = static_cast<LocationIndex>(xs_.size());
+    xs_.push_back(x);
+    ys_.push_back(y);
+
+    neighbor_ids_.resize(neighbor_ids_.size() + k_, invalid_location_index);
+    neighbor_distances_.resize(neighbor_distances_.size() + k_, 0.0);
+    neighbor_times_.resize(neighbor_times_.size() + k_, Duration{});
+    if (k_ == 0) {
+      return;
+    }
+
+    std::vector<std::pair<double, LocationIndex>> candidates;
+    fillNeighbors(index, tree, candidates);
+
+    for (LocationIndex from = 0; from < index; ++from) {
+      const std::pair candidate{computeDistance(from, index), index};
+      const std::size_t row = static_cast<std::size_t>(from) * k_;
+
+      // Rows are sorted by (distance, index); shift the farther entries right by one
+      std::size_t pos = row + k_;
+      while (pos > row &&
+             (neighbor_ids_[pos - 1] == invalid_location_index ||
+              candidate < std::pair{neighbor_distances_[pos - 1], neighbor_ids_[pos - 1]})) {
+        --pos;
+      }
+      if (pos == row + k_) {
+        continue;
+      }
+
+      std::shift_right(neighbor_ids_.begin() + pos, neighbor_ids_.begin() + row + k_, 1);
+      std::shift_right(
+        neighbor_distances_.begin() + pos, neighbor_distances_.begin() + row + k_, 1
+      );
+      std::shift_right(neighbor_times_.begin() + pos, neighbor_times_.begin() + row + k_, 1);
+
+      neighbor_ids_[pos] = index;
+      neighbor_distances_[pos] = candidate.first;
+      neighbor_times_[pos] = MatrixBuilder::travelTime(candidate.first, speed_kmh_);
+    }
+  }
+
+  [[nodiscard]] Distance distance(LocationIndex from, LocationIndex to) const {
+    if (const auto slot = findCached(from, to); slot != npos) {
+      return Distance{neighbor_distances_[slot]};
+    }
+    return Distance{computeDistance(from, to)};
+  }
+
+  [[nodiscard]] Duration travelTime(LocationIndex from, LocationIndex to) const noexcept {
+    if (const auto slot = findCached(from, to); slot != npos) {
+      return neighbor_times_[slot];
+    }
+    return MatrixBuilder::travelTime(computeDistance(from, to), speed_kmh_);
+  }
+
+  /**
+   * @brief Cached neighbors of a location, closest first
+   */
+  [[nodiscard]] std::span<const LocationIndex> neighbors(LocationIndex from) const noexcept {
+    return std::span{neighbor_ids_}.subspan(static_cast<std::size_t>(from) * k_, k_);
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return xs_.size(); }
+  [[nodiscard]] std::size_t neighborCount() const noexcept { return k_; }
+
+  [[nodiscard]] std::size_t memoryUsage() const noexcept {
+    return (xs_.capacity() + ys_.capacity() + neighbor_distances_.capacity()) * sizeof(double) +
+           neighbor_ids_.capacity() * sizeof(LocationIndex) +
+           neighbor_times_.capacity() * sizeof(Duration);
+  }
+
+  void clear() noexcept {
+    xs_.clear();
+    ys_.clear();
+    neighbor_ids_.clear();
+    neighbor_distances_.clear();
+    neighbor_times_.clear();
+    k_ = 0;
+  }
+
+ private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  double speed_kmh_{default_travel_speed_kmh};
+
+  // Row-major neighbor cache, k_ entries per location
+  std::size_t k_{0};
+  std::vector<LocationIndex> neighbor_ids_;
+  std::vector<double> neighbor_distances_;
+  std::vector<Duration> neighbor_times_;
+
+  [[nodiscard]] double computeDistance(LocationIndex from, LocationIndex to) const noexcept {
+    return MatrixBuilder::distance(xs_[from], ys_[from], xs_[to], ys_[to]);
+  }
+
+  // Cache the k nearest neighbors of one location
+  void fillNeighbors(
+    LocationIndex from,
+    const KDTree& tree,
+    std::vector<std::pair<double, LocationIndex>>& candidates
+  ) {
+    candidates.clear();
+    for (const auto to : tree.findKNearestIndices(from, k_)) {
+      candidates.emplace_back(computeDistance(from, to), to);
+    }
+
+    // Closest first, ties broken by index so the cache does not depend on tree layout
+    std::ranges::sort(candidates);
+
+    const std::size_t row = static_cast<std::size_t>(from) * k_;
+    const std::size_t count = std::min(k_, candidates.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto [dist, to] = candidates[i];
+      neighbor_ids_[row + i] = to;
+      neighbor_distances_[row + i] = dist;
+      neighbor_times_[row + i] = MatrixBuilder::travelTime(dist, speed_kmh_);
+    }
+  }
+
+  [[nodiscard]] std::size_t findCached(LocationIndex from, LocationIndex to) const noexcept {
+    const std::size_t row = static_cast<std::size_t>(from) * k_;
+    for (std::size_t i = row; i < row + k_; ++i) {
+      if (neighbor_ids_[i] == to) {
+        return i;
+      }
+    }
+    return npos;
+  }
+};
+
+}  // namespace daa
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <string>
 
 #include "concepts.h"
@@ -7,12 +9,20 @@
 
 namespace daa {
 
+// Dense index assigned to every location when a problem is loaded. Hot paths address
+// locations (and the distance/time data derived from them) by index; string IDs are kept
+// only for I/O and display.
+using LocationIndex = std::uint32_t;
+
+inline constexpr LocationIndex invalid_location_index = std::numeric_limits<LocationIndex>::max();
+
 class Location {
  public:
   class Builder;
 
  private:
   std::string id_;
+  LocationIndex index_;
   double x_;
   double y_;
   LocationType type_;
@@ -24,6 +34,7 @@ class Location {
   // Default constructor creates an empty location
   Location() noexcept
       : id_(""),
+        index_(invalid_location_index),
         x_(0.0),
         y_(0.0),
         type_(LocationType::DEPOT),
@@ -33,6 +44,7 @@ class Location {
 
   Location(
     std::string id,
+    LocationIndex index,
     double x,
     double y,
     LocationType type,
@@ -41,6 +53,7 @@ class Location {
     Capacity waste_amount
   )
       : id_(std::move(id)),
+        index_(index),
         x_(x),
         y_(y),
         type_(type),
@@ -49,6 +62,7 @@ class Location {
         waste_amount_(waste_amount) {}
 
   [[nodiscard]] const std::string& id() const noexcept { return id_; }
+  [[nodiscard]] LocationIndex index() const noexcept { return index_; }
   [[nodiscard]] double x() const noexcept { return x_; }
   [[nodiscard]] double y() const noexcept { return y_; }
   [[nodiscard]] LocationType type() const noexcept { return type_; }
@@ -60,6 +74,7 @@ class Location {
 class Location::Builder {
  private:
   std::string id_;
+  LocationIndex index_ = invalid_location_index;
   double x_ = 0.0;
   double y_ = 0.0;
   LocationType type_ = LocationType::DEPOT;
@@ -73,6 +88,11 @@ class Location::Builder {
     return *this;
   }
 
+  Builder& setIndex(LocationIndex index) {
+    index_ = index;
+    return *this;
+  }
+
   Builder& setCoordinates(double x, double y) {
     x_ = x;
     y_ = y;
@@ -100,7 +120,7 @@ class Location::Builder {
   }
 
   [[nodiscard]] Location build() const {
-    return Location(id_, x_, y_, type_, name_, service_time_, waste_amount_);
+    return Location(id_, index_, x_, y_, type_, name_, service_time_, waste_amount_);
   }
 };
 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "location.h"
+#include "strong_types.h"
+
+namespace daa {
+
+/**
+ * @class LocationTable
+ * @brief Structure-of-arrays view of the numeric location attributes
+ *
+ * Every column is indexed by LocationIndex. Solvers read coordinates, service times, waste
+ * amounts and types from here instead of touching `Location` objects, which also carry the
+ * string ID and name.
+ */
+class LocationTable {
+ public:
+  LocationTable() = default;
+
+  /**
+   * @brief Append a location. Its index must be the next free one.
+   * @throws std::invalid_argument if the location index does not match
+   */
+  void add(const Location& location) {
+    if (location.index() != xs_.size()) {
+      throw std::invalid_argument("Location index does not match its table position");
+    }
+
+    xs_.push_back(location.x());
+    ys_.push_back(location.y());
+    service_times_.push_back(location.serviceTime());
+    waste_amounts_.push_back(location.wasteAmount());
+    types_.push_back(location.type());
+  }
+
+  void reserve(std::size_t count) {
+    xs_.reserve(count);
+    ys_.reserve(count);
+    service_times_.reserve(count);
+    waste_amounts_.reserve(count);
+    types_.reserve(count);
+  }
+
+  void clear() noexcept {
+    xs_.clear();
+    ys_.clear();
+    service_times_.clear();
+    waste_amounts_.clear();
+    types_.clear();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return xs_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return xs_.empty(); }
+
+  // Per-location accessors
+  [[nodiscard]] double x(LocationIndex index) const noexcept { return xs_[index]; }
+  [[nodiscard]] double y(LocationIndex index) const noexcept { return ys_[index]; }
+  [[nodiscard]] Duration serviceTime(LocationIndex index) const noexcept {
+    return service_times_[index];
+  }
+  [[nodiscard]] Capacity wasteAmount(LocationIndex index) const noexcept {
+    return waste_amounts_[index];
+  }
+  [[nodiscard]] LocationType type(LocationIndex index) const noexcept { return types_[index]; }
+
+  // Whole columns
+  [[nodiscard]] std::span<const double> xs() const noexcept { return xs_; }
+  [[nodiscard]] std::span<const double> ys() const noexcept { return ys_; }
+  [[nodiscard]] std::span<const Duration> serviceTimes() const noexcept { return service_times_; }
+  [[nodiscard]] std::span<const Capacity> wasteAmounts() const noexcept { return waste_amounts_; }
+  [[nodiscard]] std::span<const LocationType> types() const noexcept { return types_; }
+
+ private:
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<Duration> service_times_;
+  std::vector<Capacity> waste_amounts_;
+  std::vector<LocationType> types_;
+};
+
+}  // namespace daa
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "distance_matrix.h"
+#include "strong_types.h"
+
+namespace daa {
+
+// Average vehicle speed the travel times are derived from
+inline constexpr double default_travel_speed_kmh = 50.0;
+
+/**
+ * @brief Instruction sets the matrix builder has kernels for
+ */
+enum class MatrixIsa { Scalar, AVX2, AVX512 };
+
+/**
+ * @brief Options for MatrixBuilder::build
+ */
+struct MatrixBuildOptions {
+  DistanceMatrix::Layout layout{DistanceMatrix::Layout::Full};
+  double speed_kmh{default_travel_speed_kmh};  // Average speed used to derive travel times
+  unsigned int threads{0};                     // Worker threads, 0 uses the hardware concurrency
+  std::optional<MatrixIsa> isa{};              // Force a kernel, capped to what the CPU supports
+};
+
+/**
+ * @class MatrixBuilder
+ * @brief Builds the distance and travel time matrices in one pass over SoA coordinates
+ *
+ * Each matrix row (or packed column in the symmetric layout) is filled by a vectorized kernel
+ * that computes distances and travel times together. Rows are distributed over worker threads
+ * and the kernel is selected at runtime from the widest instruction set the CPU supports. All
+ * kernels perform the same IEEE operations in the same order, so the result is bit-identical
+ * to the scalar path.
+ */
+class MatrixBuilder {
+ public:
+  /**
+   * @brief Build the matrix for points given as separate coordinate arrays
+   * @param xs X coordinates in meters, indexed by LocationIndex
+   * @param ys Y coordinates in meters, indexed by LocationIndex
+   * @param options Layout, speed, threading and kernel selection
+   * @return The filled matrix
+   * @throws std::invalid_argument if the coordinate arrays differ in length
+   */
+  [[nodiscard]] static DistanceMatrix build(
+    std::span<const double> xs,
+    std::span<const double> ys,
+    const MatrixBuildOptions& options
+  );
+
+  /**
+   * @brief Extend a matrix with the last of the given points
+   *
+   * Computes the single new row with the same kernel as build() and stores it as both the row
+   * and the column of the appended location.
+   * @param matrix Matrix over all points but the last
+   * @param xs X coordinates in meters, one more than the matrix size
+   * @param ys Y coordinates in meters, one more than the matrix size
+   * @param speed_kmh Average speed used to derive travel times
+   * @throws std::invalid_argument if the coordinates do not extend the matrix by one point
+   */
+  static void append(
+    DistanceMatrix& matrix,
+    std::span<const double> xs,
+    std::span<const double> ys,
+    double speed_kmh = default_travel_speed_kmh
+  );
+
+  /**
+   * @brief Widest instruction set supported by the running CPU
+   */
+  [[nodiscard]] static MatrixIsa detectIsa() noexcept;
+
+  [[nodiscard]] static std::string_view isaName(MatrixIsa isa) noexcept;
+
+  /**
+   * @brief Scalar reference for a single pair, matching the kernels bit for bit
+   */
+  [[nodiscard]] static double distance(double x1, double y1, double x2, double y2) noexcept;
+
+  /**
+   * @brief Travel time for a distance at the given speed, matching the kernels bit for bit
+   */
+  [[nodiscard]] static Duration travelTime(double distance_meters, double speed_kmh) noexcept;
+};
+
+}  // namespace daa
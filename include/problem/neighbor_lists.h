@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "location.h"
+
+namespace daa {
+
+/**
+ * @class NeighborLists
+ * @brief Nearest-neighbor lists of every location in compressed sparse row form
+ *
+ * Row `i` holds the neighbors of location `i`, closest first, at positions
+ * `[offsets[i], offsets[i + 1])` of the index and distance arrays. Rows may be shorter than the
+ * requested k when there are not enough candidates.
+ */
+class NeighborLists {
+ public:
+  NeighborLists() = default;
+
+  /**
+   * @throws std::invalid_argument if the arrays do not describe a valid CSR structure
+   */
+  NeighborLists(
+    std::vector<std::size_t> offsets,
+    std::vector<LocationIndex> indices,
+    std::vector<double> distances
+  )
+      : offsets_(std::move(offsets)),
+        indices_(std::move(indices)),
+        distances_(std::move(distances)) {
+    if (offsets_.empty() || offsets_.front() != 0 || offsets_.back() != indices_.size() ||
+        indices_.size() != distances_.size()) {
+      throw std::invalid_argument("Inconsistent neighbor list arrays");
+    }
+  }
+
+  // Number of rows, one per location
+  [[nodiscard]] std::size_t size() const noexcept {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  // Neighbors of a location, closest first
+  [[nodiscard]] std::span<const LocationIndex> neighbors(LocationIndex from) const noexcept {
+    return std::span{indices_}.subspan(offsets_[from], offsets_[from + 1] - offsets_[from]);
+  }
+
+  // Distances in meters, aligned with neighbors()
+  [[nodiscard]] std::span<const double> distances(LocationIndex from) const noexcept {
+    return std::span{distances_}.subspan(offsets_[from], offsets_[from + 1] - offsets_[from]);
+  }
+
+  // Raw CSR arrays
+  [[nodiscard]] std::span<const std::size_t> offsets() const noexcept { return offsets_; }
+  [[nodiscard]] std::span<const LocationIndex> indices() const noexcept { return indices_; }
+  [[nodiscard]] std::span<const double> distances() const noexcept { return distances_; }
+
+  /**
+   * @brief Append the row of a new location, closest neighbor first
+   */
+  void appendRow(std::span<const LocationIndex> neighbors, std::span<const double> distances) {
+    if (offsets_.empty()) {
+      offsets_.push_back(0);
+    }
+    indices_.insert(indices_.end(), neighbors.begin(), neighbors.end());
+    distances_.insert(distances_.end(), distances.begin(), distances.end());
+    offsets_.push_back(indices_.size());
+  }
+
+  /**
+   * @brief Offer a new neighbor to a row holding up to `k` neighbors
+   *
+   * The neighbor is inserted after those at the same distance. A full row drops its farthest
+   * neighbor to make room, and ignores neighbors farther than all of its own.
+   * @return Whether the row changed
+   */
+  bool offer(LocationIndex from, LocationIndex to, double distance, std::size_t k) {
+    const auto first = distances_.begin() + static_cast<std::ptrdiff_t>(offsets_[from]);
+    const auto last = distances_.begin() + static_cast<std::ptrdiff_t>(offsets_[from + 1]);
+    const auto pos = static_cast<std::size_t>(
+      std::upper_bound(first, last, distance) - distances_.begin()
+    );
+    const std::size_t end = offsets_[from + 1];
+
+    // A short row grows, moving every later row
+    if (end - offsets_[from] < k) {
+      indices_.insert(indices_.begin() + static_cast<std::ptrdiff_t>(pos), to);
+      distances_.insert(distances_.begin() + static_cast<std::ptrdiff_t>(pos), distance);
+      for (std::size_t row = from + 1; row < offsets_.size(); ++row) {
+        ++offsets_[row];
+      }
+      return true;
+    }
+
+    if (pos == end) {
+      return false;
+    }
+    for (std::size_t i = end - 1; i > pos; --i) {
+      indices_[i] = indices_[i - 1];
+      distances_[i] = distances_[i - 1];
+    }
+    indices_[pos] = to;
+    distances_[pos] = distance;
+    return true;
+  }
+
+  [[nodiscard]] std::size_t memoryUsage() const noexcept {
+    return offsets_.capacity() * sizeof(std::size_t) +
+           indices_.capacity() * sizeof(LocationIndex) + distances_.capacity() * sizeof(double);
+  }
+
+ private:
+  std::vector<std::size_t> offsets_;
+  std::vector<LocationIndex> indices_;
+  std::vector<double> distances_;
+};
+
+}  // namespace daa
@@ -1,9 +1,9 @@
 #pragma once
 
 #include <ranges>
-#include <string>
 #include <vector>
 
+#include "distance_matrix.h"
 #include "kdtree.h"
 #include "location.h"
 #include "strong_types.h"
@@ -12,14 +12,14 @@ namespace daa {
 
 class Route {
  private:
-  std::vector<std::string> sequence_;
+  std::vector<LocationIndex> sequence_;
   Capacity current_load_{0.0};
   Duration total_duration_{0.0};
 
  public:
   [[nodiscard]] bool canAdd(
     const Location& loc,
-    const KDTree& kd_tree,
+    const DistanceMatrix& matrix,
     const Capacity& max_capacity,
     const Duration& max_duration
   ) const {
@@ -27,8 +27,7 @@ class Route {
       return true;
     }
 
-    const auto& last_id = sequence_.back();
-    const auto time_to_loc = kd_tree.getTravelTime(last_id, loc.id());
+    const auto time_to_loc = matrix.travelTime(sequence_.back(), loc.index());
     const auto new_duration = total_duration_ + time_to_loc + loc.serviceTime();
     const auto new_load = Capacity{current_load_.value() + loc.wasteAmount().value()};
 
@@ -36,20 +35,19 @@ class Route {
            new_duration.nanoseconds() <= max_duration.nanoseconds();
   }
 
-  void add(const Location& loc, const KDTree& kd_tree) {
+  void add(const Location& loc, const DistanceMatrix& matrix) {
     if (!sequence_.empty()) {
-      const auto& last_id = sequence_.back();
-      const auto time_to_loc = kd_tree.getTravelTime(last_id, loc.id());
+      const auto time_to_loc = matrix.travelTime(sequence_.back(), loc.index());
       total_duration_ += time_to_loc + loc.serviceTime();
     }
 
-    sequence_.push_back(loc.id());
+    sequence_.push_back(loc.index());
     current_load_ = Capacity{current_load_.value() + loc.wasteAmount().value()};
   }
 
   void resetLoad() { current_load_ = Capacity{0.0}; }
 
-  [[nodiscard]] const std::vector<std::string>& sequence() const noexcept { return sequence_; }
+  [[nodiscard]] const std::vector<LocationIndex>& sequence() const noexcept { return sequence_; }
   [[nodiscard]] const Capacity& currentLoad() const noexcept { return current_load_; }
   [[nodiscard]] const Duration& totalDuration() const noexcept { return total_duration_; }
 
@@ -60,9 +58,8 @@ class Route {
     const auto& locations = kdtree.getLocations();
 
     return sequence_ |
-           std::ranges::views::transform([&locations](const auto& id) -> const Location* {
-             auto it = locations.find(id);
-             return it != locations.end() ? &it->second : nullptr;
+           std::ranges::views::transform([&locations](LocationIndex index) -> const Location* {
+             return index < locations.size() ? &locations[index] : nullptr;
            }) |
            std::ranges::views::filter([](const Location* loc) { return loc != nullptr; }) |
            std::ranges::to<std::vector>();
@@ -1,16 +1,29 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <iostream>
 #include <optional>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "concepts.h"
+#include "distance_matrix.h"
 #include "kdtree.h"
+#include "lazy_distance_provider.h"
 #include "location.h"
+#include "location_table.h"
+#include "matrix_builder.h"
+#include "neighbor_lists.h"
 #include "parser/vrpt_driver.h"
 #include "problem/units.h"
 #include "strong_types.h"
@@ -24,6 +37,19 @@ class VRPTSolution;
 
 namespace daa {
 
+// Zone neighbors cached per location when the instance does not set its k parameter
+inline constexpr std::size_t default_zone_neighbor_count = 8;
+
+/**
+ * @brief Precomputed way back to the depot from a location, unloading at its nearest SWTS
+ */
+struct DepotReturn {
+  LocationIndex nearest_swts{invalid_location_index};  // The location itself for an SWTS
+  Duration to_swts{};                                  // Travel time to the nearest SWTS
+  Duration swts_to_depot{};                            // Travel time from that SWTS to the depot
+  Duration total{};                                    // Time to unload and reach the depot
+};
+
 /**
  * @class VRPTProblem
  * @brief Class representing the Vehicle Routing Problem with Transshipments for Solid Waste
@@ -56,19 +82,41 @@ class VRPTProblem {
   // KDTree for spatial queries
   KDTree location_tree_;
 
-  // Specialized location IDs for quick access
-  std::string depot_id_;
-  std::string landfill_id_;
-  std::vector<std::string> swts_ids_;
-  std::vector<std::string> zone_ids_;
+  // Numeric location attributes as parallel arrays, indexed by LocationIndex
+  LocationTable location_table_;
+
+  // Pairwise distances and travel times, indexed by LocationIndex. Only one of the two is
+  // populated, depending on the resolved distance mode.
+  DistanceMode distance_mode_{DistanceMode::Dense};
+  DistanceMatrix distance_matrix_;
+  LazyDistanceProvider lazy_distances_;
+
+  // Specialized location indices for quick access
+  LocationIndex depot_index_{invalid_location_index};
+  LocationIndex landfill_index_{invalid_location_index};
+  std::vector<LocationIndex> swts_indices_;
+  std::vector<LocationIndex> zone_indices_;
+
+  // Return path to the depot for every location, indexed by LocationIndex
+  std::vector<DepotReturn> depot_returns_;
+
+  // Nearest collection zones of every location, built once per problem
+  NeighborLists zone_neighbors_;
+
+  // Identifies the current locations, renewed by every load and added zone
+  std::uint64_t generation_{0};
+
+  // String ID to dense index mapping, only used for I/O and display lookups
+  std::unordered_map<std::string, LocationIndex> location_indices_;
 
  public:
   // Default constructor
   VRPTProblem() = default;
 
-  static std::optional<VRPTProblem> loadFile(const std::string& filepath) {
+  static std::optional<VRPTProblem>
+    loadFile(const std::string& filepath, const DistanceOptions& distance_options = {}) {
     VRPTProblem problem;
-    if (!problem.loadFromFile(filepath)) {
+    if (!problem.loadFromFile(filepath, distance_options)) {
       return std::nullopt;
     }
     return problem;
@@ -77,9 +125,10 @@ class VRPTProblem {
   /**
    * @brief Load problem from a file
    * @param filepath Path to the input file
+   * @param distance_options How distances are stored: dense matrix, lazy, or chosen by size
    * @return True if loading was successful, false otherwise
    */
-  bool loadFromFile(const std::string& filepath) {
+  bool loadFromFile(const std::string& filepath, const DistanceOptions& distance_options = {}) {
     try {
       // Use the VRPT parser to parse the file
       VRPTDriver driver;
@@ -89,10 +138,13 @@ class VRPTProblem {
       }
 
       // Clear previous data
-      depot_id_.clear();
-      landfill_id_.clear();
-      swts_ids_.clear();
-      zone_ids_.clear();
+      generation_ = nextGeneration();
+      depot_index_ = invalid_location_index;
+      landfill_index_ = invalid_location_index;
+      swts_indices_.clear();
+      zone_indices_.clear();
+      location_indices_.clear();
+      location_table_.clear();
 
       // Temporary storage for locations before building the KDTree
       std::vector<Location> locations;
@@ -118,12 +170,16 @@ class VRPTProblem {
       offset_ = driver.parameters.offset;
       k_param_ = driver.parameters.k_param;
 
+      // Dense indices are assigned in load order
+      auto next_index = [&locations]() { return static_cast<LocationIndex>(locations.size()); };
+
       // Process locations
       for (const auto& loc : driver.locations) {
         if (loc.type == "Depot") {
-          depot_id_ = "depot";
+          depot_index_ = next_index();
           auto depot = Location::Builder()
-                         .setId(depot_id_)
+                         .setId("depot")
+                         .setIndex(depot_index_)
                          .setCoordinates(loc.x * 1000.0, loc.y * 1000.0)  // Convert km to m
                          .setType(LocationType::DEPOT)
                          .setName("Depot")
@@ -133,9 +189,10 @@ class VRPTProblem {
 
           locations.push_back(depot);
         } else if (loc.type == "Dumpsite") {
-          landfill_id_ = "landfill";
+          landfill_index_ = next_index();
           auto landfill = Location::Builder()
-                            .setId(landfill_id_)
+                            .setId("landfill")
+                            .setIndex(landfill_index_)
                             .setCoordinates(loc.x * 1000.0, loc.y * 1000.0)  // Convert km to m
                             .setType(LocationType::LANDFILL)
                             .setName("Landfill")
@@ -146,8 +203,10 @@ class VRPTProblem {
           locations.push_back(landfill);
         } else if (loc.type == "IF" || loc.type == "IF1") {
           std::string swts_id = "swts_" + loc.type;
+          swts_indices_.push_back(next_index());
           auto swts = Location::Builder()
                         .setId(swts_id)
+                        .setIndex(swts_indices_.back())
                         .setCoordinates(loc.x * 1000.0, loc.y * 1000.0)  // Convert km to m
                         .setType(LocationType::SWTS)
                         .setName("SWTS " + loc.type)
@@ -156,15 +215,16 @@ class VRPTProblem {
                         .build();
 
           locations.push_back(swts);
-          swts_ids_.push_back(swts_id);
         }
       }
 
       // Process zones
       for (const auto& zone : driver.zones) {
         std::string id = "zone_" + std::to_string(zone.id);
+        zone_indices_.push_back(next_index());
         auto zone_loc = Location::Builder()
                           .setId(id)
+                          .setIndex(zone_indices_.back())
                           .setCoordinates(zone.x * 1000.0, zone.y * 1000.0)  // Convert km to m
                           .setType(LocationType::COLLECTION_ZONE)
                           .setName("Zone " + std::to_string(zone.id))
@@ -173,18 +233,28 @@ class VRPTProblem {
                           .build();
 
         locations.push_back(zone_loc);
-        zone_ids_.push_back(id);
+      }
+
+      location_table_.reserve(locations.size());
+      for (const auto& location : locations) {
+        location_indices_.emplace(location.id(), location.index());
+        location_table_.add(location);
       }
 
       // Build the KDTree with all locations
       location_tree_.build(std::move(locations));
+      buildDistances(distance_options);
 
       // Check if we have all the required elements
-      if (depot_id_.empty() || landfill_id_.empty() || swts_ids_.empty() || zone_ids_.empty()) {
+      if (depot_index_ == invalid_location_index || landfill_index_ == invalid_location_index ||
+          swts_indices_.empty() || zone_indices_.empty()) {
         std::cerr << "Error: Missing required elements in problem definition" << std::endl;
         return false;
       }
 
+      buildDepotReturns();
+      buildZoneNeighbors();
+
       return true;
     } catch (const std::exception& e) {
       std::cerr << "Error loading problem: " << e.what() << std::endl;
@@ -192,6 +262,62 @@ class VRPTProblem {
     }
   }
 
+  /**
+   * @brief Add a collection zone to a loaded problem, e.g. an on-call pickup
+   *
+   * The zone is inserted into the spatial index and gets a single new distance row and column.
+   * The zone neighbor lists gain a row for it and take it into the rows it is now among the
+   * nearest of, so the cost grows with the number of locations instead of rebuilding everything.
+   * @param id Unique location ID
+   * @param x X coordinate in meters
+   * @param y Y coordinate in meters
+   * @param service_time Time spent collecting at the zone
+   * @param waste_amount Waste collected at the zone
+   * @return Index of the new zone
+   * @throws std::invalid_argument if the ID is already in use
+   */
+  LocationIndex addZone(
+    const std::string& id,
+    double x,
+    double y,
+    Duration service_time,
+    Capacity waste_amount
+  ) {
+    if (location_indices_.contains(id)) {
+      throw std::invalid_argument("Location ID already in use: " + id);
+    }
+
+    const auto index = static_cast<LocationIndex>(location_table_.size());
+    auto zone = Location::Builder()
+                  .setId(id)
+                  .setIndex(index)
+                  .setCoordinates(x, y)
+                  .setType(LocationType::COLLECTION_ZONE)
+                  .setName("Zone " + id)
+                  .setServiceTime(service_time)
+                  .setWasteAmount(waste_amount)
+                  .build();
+
+    location_table_.add(zone);
+    location_indices_.emplace(id, index);
+    zone_indices_.push_back(index);
+    ++num_zones_;
+    location_tree_.insert(std::move(zone));
+
+    if (distance_mode_ == DistanceMode::Dense) {
+      MatrixBuilder::append(distance_matrix_, location_table_.xs(), location_table_.ys());
+    } else {
+      lazy_distances_.append(x, y, location_tree_);
+    }
+
+    depot_returns_.push_back(computeDepotReturn(index));
+
+    addZoneNeighbors(index);
+    generation_ = nextGeneration();
+
+    return index;
+  }
+
   /**
    * @brief Evaluate solution quality - primary objective is to minimize the number of CV vehicles
    * @param solution The solution to evaluate
@@ -214,59 +340,47 @@ class VRPTProblem {
    * @throws std::runtime_error if depot not found
    */
   [[nodiscard]] const Location& getDepot() const {
-    if (depot_id_.empty()) {
+    if (depot_index_ == invalid_location_index) {
       throw std::runtime_error("Depot not found");
     }
-    return location_tree_.getLocations().at(depot_id_);
+    return location_tree_.getLocation(depot_index_);
   }
 
+  /**
+   * @brief Get the index of the depot location
+   * @return The depot index, or invalid_location_index if no problem is loaded
+   */
+  [[nodiscard]] LocationIndex getDepotIndex() const noexcept { return depot_index_; }
+
   /**
    * @brief Get the landfill location
    * @return The landfill location
    * @throws std::runtime_error if landfill not found
    */
   [[nodiscard]] const Location& getLandfill() const {
-    if (landfill_id_.empty()) {
+    if (landfill_index_ == invalid_location_index) {
       throw std::runtime_error("Landfill not found");
     }
-    return location_tree_.getLocations().at(landfill_id_);
+    return location_tree_.getLocation(landfill_index_);
   }
 
   /**
-   * @brief Get all SWTS locations
-   * @return Vector of SWTS locations
+   * @brief Get the index of the landfill location
+   * @return The landfill index, or invalid_location_index if no problem is loaded
    */
-  [[nodiscard]] std::vector<Location> getSWTS() const {
-    std::vector<Location> result;
-    const auto& locations = location_tree_.getLocations();
+  [[nodiscard]] LocationIndex getLandfillIndex() const noexcept { return landfill_index_; }
 
-    for (const auto& id : swts_ids_) {
-      auto it = locations.find(id);
-      if (it != locations.end()) {
-        result.push_back(it->second);
-      }
-    }
-
-    return result;
-  }
+  /**
+   * @brief Get all SWTS locations
+   * @return View over the SWTS location indices
+   */
+  [[nodiscard]] std::span<const LocationIndex> getSWTS() const noexcept { return swts_indices_; }
 
   /**
    * @brief Get all collection zone locations
-   * @return Vector of collection zone locations
+   * @return View over the collection zone location indices
    */
-  [[nodiscard]] std::vector<Location> getZones() const {
-    std::vector<Location> result;
-    const auto& locations = location_tree_.getLocations();
-
-    for (const auto& id : zone_ids_) {
-      auto it = locations.find(id);
-      if (it != locations.end()) {
-        result.push_back(it->second);
-      }
-    }
-
-    return result;
-  }
+  [[nodiscard]] std::span<const LocationIndex> getZones() const noexcept { return zone_indices_; }
 
   /**
    * @brief Get a specific location by ID
@@ -275,32 +389,90 @@ class VRPTProblem {
    * @throws std::runtime_error if location not found
    */
   [[nodiscard]] const Location& getLocation(const std::string& id) const {
-    const auto& locations = location_tree_.getLocations();
-    auto it = locations.find(id);
-    if (it == locations.end()) {
+    return location_tree_.getLocation(getLocationIndex(id));
+  }
+
+  /**
+   * @brief Get a specific location by index
+   * @param index The location index
+   * @return The location
+   */
+  [[nodiscard]] const Location& getLocation(LocationIndex index) const {
+    return location_tree_.getLocation(index);
+  }
+
+  /**
+   * @brief Resolve a location ID to its dense index
+   * @param id The location ID
+   * @return The location index
+   * @throws std::runtime_error if location not found
+   */
+  [[nodiscard]] LocationIndex getLocationIndex(const std::string& id) const {
+    auto it = location_indices_.find(id);
+    if (it == location_indices_.end()) {
       throw std::runtime_error("Location not found: " + id);
     }
     return it->second;
   }
 
+  /**
+   * @brief Get the number of locations (depot, landfill, SWTS and zones)
+   */
+  [[nodiscard]] size_t getLocationCount() const noexcept { return location_tree_.size(); }
+
+  /**
+   * @brief Get the precomputed return path to the depot through the nearest SWTS
+   * @param index The location index
+   */
+  [[nodiscard]] const DepotReturn& getDepotReturn(LocationIndex index) const noexcept {
+    return depot_returns_[index];
+  }
+
+  /**
+   * @brief Get the SWTS nearest to a location (the location itself for an SWTS)
+   * @param index The location index
+   */
+  [[nodiscard]] LocationIndex getNearestSWTS(LocationIndex index) const noexcept {
+    return depot_returns_[index].nearest_swts;
+  }
+
   /**
    * @brief Find nearest location of a specific type
    * @param from Source location
    * @param type Type of location to find
-   * @return Nearest location of specified type or nullopt if not found
+   * @return Index of the nearest location of specified type or nullopt if not found
    */
-  [[nodiscard]] std::optional<Location> findNearest(const Location& from, LocationType type) const {
+  [[nodiscard]] std::optional<LocationIndex>
+    findNearest(const Location& from, LocationType type) const {
+    return location_tree_.findNearest(from, type);
+  }
+
+  [[nodiscard]] std::optional<LocationIndex> findNearest(LocationIndex from, LocationType type)
+    const {
     return location_tree_.findNearest(from, type);
   }
 
+  /**
+   * @brief Find the nearest location of a specific type accepted by a filter
+   * @param from Source location
+   * @param type Type of location to find
+   * @param filter Predicate over candidate location indices
+   * @return Index of the nearest accepted location or nullopt if not found
+   */
+  template <std::predicate<LocationIndex> Filter>
+  [[nodiscard]] std::optional<LocationIndex>
+    findNearest(const Location& from, LocationType type, const Filter& filter) const {
+    return location_tree_.findNearest(from, type, filter);
+  }
+
   /**
    * @brief Find k nearest locations of a specific type
    * @param from Source location
    * @param type Type of location to find
    * @param k Number of nearest neighbors to find
-   * @return Vector of k nearest locations of the specified type
+   * @return Indices of the k nearest locations of the specified type, closest first
    */
-  [[nodiscard]] std::vector<Location>
+  [[nodiscard]] std::vector<LocationIndex>
     findKNearest(const Location& from, LocationType type, size_t k) const {
     return location_tree_.findKNearest(from, type, k);
   }
@@ -312,7 +484,20 @@ class VRPTProblem {
    * @return Distance between locations
    */
   [[nodiscard]] Distance getDistance(const std::string& from_id, const std::string& to_id) const {
-    return location_tree_.getDistance(from_id, to_id);
+    return getDistance(getLocationIndex(from_id), getLocationIndex(to_id));
+  }
+
+  /**
+   * @brief Get distance between two locations
+   * @param from Source location index
+   * @param to Target location index
+   * @return Distance between locations
+   */
+  [[nodiscard]] Distance getDistance(LocationIndex from, LocationIndex to) const {
+    if (distance_mode_ == DistanceMode::Dense) {
+      return distance_matrix_.distance(from, to);
+    }
+    return lazy_distances_.distance(from, to);
   }
 
   /**
@@ -322,17 +507,88 @@ class VRPTProblem {
    * @return Travel time between locations
    */
   [[nodiscard]] Duration getTravelTime(const std::string& from_id, const std::string& to_id) const {
-    return location_tree_.getTravelTime(from_id, to_id);
+    return getTravelTime(getLocationIndex(from_id), getLocationIndex(to_id));
+  }
+
+  /**
+   * @brief Get travel time between two locations
+   * @param from Source location index
+   * @param to Target location index
+   * @return Travel time between locations
+   */
+  [[nodiscard]] Duration getTravelTime(LocationIndex from, LocationIndex to) const {
+    if (distance_mode_ == DistanceMode::Dense) {
+      return distance_matrix_.travelTime(from, to);
+    }
+    return lazy_distances_.travelTime(from, to);
+  }
+
+  /**
+   * @brief Get the location attributes as structure-of-arrays columns
+   */
+  [[nodiscard]] const LocationTable& getLocationTable() const noexcept { return location_table_; }
+
+  /**
+   * @brief Get the resolved distance mode, either Dense or Lazy
+   */
+  [[nodiscard]] DistanceMode getDistanceMode() const noexcept { return distance_mode_; }
+
+  /**
+   * @brief Get the precomputed distance and travel time matrix (empty in lazy mode)
+   */
+  [[nodiscard]] const DistanceMatrix& getDistanceMatrix() const noexcept {
+    return distance_matrix_;
+  }
+
+  /**
+   * @brief Get the on-demand distance provider (empty in dense mode)
+   */
+  [[nodiscard]] const LazyDistanceProvider& getLazyDistances() const noexcept {
+    return lazy_distances_;
   }
 
   [[nodiscard]] Duration getEpsilon() const noexcept { return epsilon_; }
 
+  /**
+   * @brief Number of zone neighbors cached per location: the instance's k, or a default
+   */
+  [[nodiscard]] std::size_t getZoneNeighborCount() const noexcept {
+    return k_param_ > 0 ? static_cast<std::size_t>(k_param_) : default_zone_neighbor_count;
+  }
+
+  /**
+   * @brief Nearest collection zones of every location, closest first
+   *
+   * Each row holds up to getZoneNeighborCount() zones and never the location itself. Used for
+   * granular neighborhoods and candidate lists.
+   */
+  [[nodiscard]] const NeighborLists& getZoneNeighbors() const noexcept { return zone_neighbors_; }
+
+  /**
+   * @brief Identifies the current locations of the problem
+   *
+   * Renewed by every load and added zone, and never shared with another problem except a copy.
+   * Data derived from the locations can be cached under it instead of under the problem address.
+   */
+  [[nodiscard]] std::uint64_t getGeneration() const noexcept { return generation_; }
+
+  /**
+   * @brief Compute the k nearest locations of a type for every location
+   * @param type Type of the neighbors
+   * @param k Neighbors per location
+   * @return One row per LocationIndex, closest first
+   */
+  [[nodiscard]] NeighborLists findKNearestAll(LocationType type, size_t k) const {
+    return location_tree_.findKNearestAll(type, k);
+  }
+
   /**
    * @brief Check if the problem is loaded
    * @return True if problem data is loaded, false otherwise
    */
   [[nodiscard]] bool isLoaded() const noexcept {
-    return !depot_id_.empty() && !landfill_id_.empty() && !zone_ids_.empty();
+    return depot_index_ != invalid_location_index && landfill_index_ != invalid_location_index &&
+           !zone_indices_.empty();
   }
 
   /**
@@ -354,9 +610,6 @@ class VRPTProblem {
     oss << "V " << vehicle_speed_.getValue(units::DistanceUnit::Kilometers, units::TimeUnit::Hours)
         << '\n';
 
-    // Locations
-    const auto& locations = location_tree_.getLocations();
-
     // Depot
     try {
       const auto& depot = getDepot();
@@ -366,13 +619,10 @@ class VRPTProblem {
     }
 
     // SWTS locations
-    for (const auto& id : swts_ids_) {
-      auto it = locations.find(id);
-      if (it != locations.end()) {
-        const auto& swts = it->second;
-        std::string if_name = swts.name().substr(5);
-        oss << if_name << " " << (swts.x() / 1000.0) << " " << (swts.y() / 1000.0) << '\n';
-      }
+    for (const auto index : swts_indices_) {
+      const auto& swts = location_tree_.getLocation(index);
+      std::string if_name = swts.name().substr(5);
+      oss << if_name << " " << (swts.x() / 1000.0) << " " << (swts.y() / 1000.0) << '\n';
     }
 
     // Landfill
@@ -389,20 +639,123 @@ class VRPTProblem {
     oss << "k " << k_param_ << '\n';
 
     // Collection zones
-    for (const auto& id : zone_ids_) {
-      auto it = locations.find(id);
-      if (it != locations.end()) {
-        const auto& zone = it->second;
-        // Extract zone number from ID, assuming format like "zone_1"
-        std::string zone_number = id.substr(5);
-        oss << zone_number << " " << zone.x() << " " << zone.y() << " "
-            << zone.wasteAmount().value() << " "
-            << zone.serviceTime().value(units::TimeUnit::Seconds) << '\n';
-      }
+    for (const auto index : zone_indices_) {
+      const auto& zone = location_tree_.getLocation(index);
+      // Loaded zones have IDs like "zone_1"; zones added later may use any ID
+      const std::string_view id = zone.id();
+      const std::string_view zone_number = id.starts_with("zone_") ? id.substr(5) : id;
+      oss << zone_number << " " << zone.x() << " " << zone.y() << " "
+          << zone.wasteAmount().value() << " "
+          << zone.serviceTime().value(units::TimeUnit::Seconds) << '\n';
     }
 
     return oss.str();
   }
+
+ private:
+  // Generations are unique across all problems; 0 is left for a problem never loaded
+  [[nodiscard]] static std::uint64_t nextGeneration() noexcept {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Resolve the nearest SWTS of every location once, so route feasibility checks never query the
+  // KD-tree. An SWTS unloads in place and goes straight back to the depot.
+  void buildDepotReturns() {
+    const auto count = static_cast<LocationIndex>(location_table_.size());
+    depot_returns_.clear();
+    depot_returns_.reserve(count);
+
+    for (LocationIndex index = 0; index < count; ++index) {
+      depot_returns_.push_back(computeDepotReturn(index));
+    }
+  }
+
+  [[nodiscard]] DepotReturn computeDepotReturn(LocationIndex index) const {
+    DepotReturn entry;
+
+    if (location_table_.type(index) == LocationType::SWTS) {
+      entry.nearest_swts = index;
+    } else if (auto nearest = location_tree_.findNearest(index, LocationType::SWTS)) {
+      entry.nearest_swts = *nearest;
+    }
+
+    if (entry.nearest_swts == invalid_location_index) {
+      entry.total = getTravelTime(index, depot_index_);
+      return entry;
+    }
+
+    entry.to_swts = getTravelTime(index, entry.nearest_swts);
+    entry.swts_to_depot = getTravelTime(entry.nearest_swts, depot_index_);
+    entry.total = entry.to_swts + entry.swts_to_depot;
+    return entry;
+  }
+
+  void buildZoneNeighbors() {
+    zone_neighbors_ =
+      location_tree_.findKNearestAll(LocationType::COLLECTION_ZONE, getZoneNeighborCount());
+  }
+
+  // Update the zone neighbor lists for a zone just added as the last location: one distance per
+  // location instead of a k-nearest query for every row
+  void addZoneNeighbors(LocationIndex zone) {
+    if (zone_neighbors_.size() != zone) {
+      buildZoneNeighbors();
+      return;
+    }
+
+    const std::size_t k = getZoneNeighborCount();
+    const auto xs = location_table_.xs();
+    const auto ys = location_table_.ys();
+
+    std::vector<std::pair<double, LocationIndex>> candidates;
+    candidates.reserve(zone_indices_.size());
+    for (LocationIndex from = 0; from < zone; ++from) {
+      const double distance = MatrixBuilder::distance(xs[from], ys[from], xs[zone], ys[zone]);
+      zone_neighbors_.offer(from, zone, distance, k);
+      if (location_table_.type(from) == LocationType::COLLECTION_ZONE) {
+        candidates.emplace_back(distance, from);
+      }
+    }
+
+    const std::size_t count = std::min(k, candidates.size());
+    std::partial_sort(
+      candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), candidates.end()
+    );
+    std::vector<LocationIndex> neighbors;
+    std::vector<double> distances;
+    for (std::size_t i = 0; i < count; ++i) {
+      distances.push_back(candidates[i].first);
+      neighbors.push_back(candidates[i].second);
+    }
+    zone_neighbors_.appendRow(neighbors, distances);
+  }
+
+  // Pick dense or lazy storage and compute distances once the locations are loaded
+  void buildDistances(const DistanceOptions& options) {
+    const std::size_t count = location_table_.size();
+    const std::size_t dense_bytes =
+      DistanceMatrix::entryCount(count, options.layout) * (sizeof(double) + sizeof(Duration));
+
+    distance_mode_ = options.mode;
+    if (distance_mode_ == DistanceMode::Auto) {
+      distance_mode_ =
+        dense_bytes <= options.memory_budget ? DistanceMode::Dense : DistanceMode::Lazy;
+    }
+
+    distance_matrix_.clear();
+    lazy_distances_.clear();
+
+    if (distance_mode_ == DistanceMode::Dense) {
+      distance_matrix_ = MatrixBuilder::build(
+        location_table_.xs(), location_table_.ys(), {.layout = options.layout}
+      );
+    } else {
+      lazy_distances_.build(
+        location_table_.xs(), location_table_.ys(), location_tree_, options.neighbor_count
+      );
+    }
+  }
 };
 
 }  // namespace daa
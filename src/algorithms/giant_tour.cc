@@ -0,0 +1,172 @@
+#include "algorithms/giant_tour.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algorithms/route_segment.h"
+
+namespace daa {
+namespace algorithm {
+
+namespace {
+
+// Best way found to serve a prefix of the tour
+struct SplitLabel {
+  std::size_t routes{0};
+  Duration duration{};
+  std::size_t from{0};  // First zone of the last route
+  bool reached{false};
+
+  [[nodiscard]] bool isBetterThan(const SplitLabel& other) const {
+    if (!other.reached) {
+      return true;
+    }
+    if (routes != other.routes) {
+      return routes < other.routes;
+    }
+    return duration < other.duration;
+  }
+};
+
+// Whether a route serving only this zone would be feasible
+bool isServable(LocationIndex zone, const VRPTProblem& problem) {
+  const RouteSegment route = RouteSegment::route(
+    problem,
+    RouteSegment::single(zone, problem),
+    RouteSegment::single(problem.getNearestSWTS(zone), problem),
+    RouteSegment::single(problem.getDepotIndex(), problem)
+  );
+  return route.isFeasibleRoute(problem);
+}
+
+/**
+ * Route serving zones [begin, end) in order: a leg ends at the SWTS nearest to its last zone as
+ * soon as the next zone no longer fits in the vehicle, and the route returns to the depot after
+ * unloading the last leg. Used to rebuild the routes chosen by decode(), which prices the same
+ * routes incrementally.
+ */
+std::vector<LocationIndex> routeLocations(
+  const std::vector<LocationIndex>& zones,
+  std::size_t begin,
+  std::size_t end,
+  const VRPTProblem& problem
+) {
+  const auto& table = problem.getLocationTable();
+  std::vector<LocationIndex> locations;
+  Capacity load{0.0};
+
+  for (std::size_t k = begin; k < end; ++k) {
+    if (k > begin && load + table.wasteAmount(zones[k]) > problem.getCVCapacity()) {
+      locations.push_back(problem.getNearestSWTS(zones[k - 1]));
+      load = Capacity{0.0};
+    }
+    locations.push_back(zones[k]);
+    load = load + table.wasteAmount(zones[k]);
+  }
+
+  locations.push_back(problem.getNearestSWTS(zones[end - 1]));
+  locations.push_back(problem.getDepotIndex());
+  return locations;
+}
+
+}  // namespace
+
+GiantTour GiantTour::fromSolution(const VRPTSolution& solution, const VRPTProblem& problem) {
+  std::vector<LocationIndex> zones;
+  zones.reserve(problem.getZones().size());
+
+  std::vector<bool> visited(problem.getLocationCount(), false);
+  for (const auto& route : solution.getCVRoutes()) {
+    for (const auto zone : route.zones()) {
+      if (!visited[zone]) {
+        visited[zone] = true;
+        zones.push_back(zone);
+      }
+    }
+  }
+
+  for (const auto zone : problem.getZones()) {
+    if (!visited[zone]) {
+      zones.push_back(zone);
+    }
+  }
+  return GiantTour(std::move(zones));
+}
+
+VRPTSolution GiantTour::decode(const VRPTProblem& problem) const {
+  // Zones that fit in no route are skipped. Every other zone can make a route on its own, so
+  // each prefix of the tour has a split.
+  std::vector<LocationIndex> zones;
+  zones.reserve(zones_.size());
+  for (const auto zone : zones_) {
+    if (isServable(zone, problem)) {
+      zones.push_back(zone);
+    }
+  }
+
+  const auto& table = problem.getLocationTable();
+  const RouteSegment depot = RouteSegment::single(problem.getDepotIndex(), problem);
+
+  // labels[j] is the best split of the first j zones
+  std::vector<SplitLabel> labels(zones.size() + 1);
+  labels[0].reached = true;
+
+  for (std::size_t i = 0; i < zones.size(); ++i) {
+    if (!labels[i].reached) {
+      continue;
+    }
+
+    // Grow the route starting at zone i one zone at a time: `closed` holds the unloaded legs
+    // and `open` the leg in progress, so each candidate costs a few O(1) concatenations
+    RouteSegment closed = RouteSegment::routeStart(problem);
+    RouteSegment open;
+    for (std::size_t j = i; j < zones.size(); ++j) {
+      if (j > i && open.tailLoad() + table.wasteAmount(zones[j]) > problem.getCVCapacity()) {
+        const auto swts = RouteSegment::single(problem.getNearestSWTS(zones[j - 1]), problem);
+        closed = RouteSegment::concat(problem, closed, open, swts);
+        open = RouteSegment();
+      }
+      open = RouteSegment::concat(open, RouteSegment::single(zones[j], problem), problem);
+
+      // The return checks only get stricter as zones are appended
+      if (RouteSegment::concat(closed, open, problem).returnNeed() >
+          problem.getCVMaxDuration()) {
+        break;
+      }
+
+      const auto swts = RouteSegment::single(problem.getNearestSWTS(zones[j]), problem);
+      const RouteSegment route = RouteSegment::concat(problem, closed, open, swts, depot);
+      if (!route.isFeasibleRoute(problem)) {
+        continue;
+      }
+
+      const SplitLabel label{labels[i].routes + 1, labels[i].duration + route.duration(), i, true};
+      if (label.isBetterThan(labels[j + 1])) {
+        labels[j + 1] = label;
+      }
+    }
+  }
+
+  // Recover the routes from the end of the tour backwards
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  for (std::size_t j = zones.size(); j > 0; j = labels[j].from) {
+    ranges.emplace_back(labels[j].from, j);
+  }
+
+  VRPTSolution solution;
+  int route_count = 1;
+  for (auto it = ranges.rbegin(); it != ranges.rend(); ++it) {
+    CVRoute route(
+      "CV" + std::to_string(route_count++), problem.getCVCapacity(), problem.getCVMaxDuration()
+    );
+    for (const auto location : routeLocations(zones, it->first, it->second, problem)) {
+      route.addLocation(location, problem);
+    }
+    solution.addCVRoute(std::move(route));
+  }
+  return solution;
+}
+
+}  // namespace algorithm
+}  // namespace daa
@@ -0,0 +1,149 @@
+#include "algorithms/incumbent_store.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace daa {
+namespace algorithm {
+
+IncumbentStore::ReadGuard::~ReadGuard() {
+  if (slot_ != nullptr) {
+    slot_->store(0);
+  }
+}
+
+const VRPTSolution& IncumbentStore::ReadGuard::operator*() const noexcept {
+  return entry_->solution;
+}
+
+SolutionScore IncumbentStore::ReadGuard::score() const noexcept {
+  return entry_ != nullptr ? entry_->score : SolutionScore{};
+}
+
+IncumbentStore::~IncumbentStore() {
+  delete current_.load();
+  for (Entry* entry = retired_.load(); entry != nullptr;) {
+    delete std::exchange(entry, entry->next_retired);
+  }
+}
+
+bool IncumbentStore::offer(const VRPTSolution& candidate) {
+  const SolutionScore score = candidate.score();
+  if (!wouldImprove(score)) {
+    return false;
+  }
+
+  // Copy outside of any critical section; most offers never get here
+  auto* entry = new Entry{score, candidate};
+
+  Entry* previous = nullptr;
+  {
+    // The current entry is dereferenced below, so it must be protected like a read
+    ReadGuard guard(&enter(), nullptr);
+
+    previous = current_.load();
+    do {
+      if (previous != nullptr && !score.isBetterThan(previous->score)) {
+        delete entry;
+        return false;
+      }
+    } while (!current_.compare_exchange_weak(previous, entry));
+  }
+
+  // Lower the best score, unless a better solution got published in the meantime
+  SolutionScore best = best_score_.load();
+  while (score.isBetterThan(best) && !best_score_.compare_exchange_weak(best, score)) {
+  }
+
+  if (previous != nullptr) {
+    retire(previous);
+  }
+  return true;
+}
+
+void IncumbentStore::clear() {
+  best_score_.store(SolutionScore{});
+  if (Entry* previous = current_.exchange(nullptr)) {
+    retire(previous);
+  }
+}
+
+IncumbentStore::ReadGuard IncumbentStore::read() const {
+  auto& slot = enter();
+  return {&slot, current_.load()};
+}
+
+std::optional<VRPTSolution> IncumbentStore::snapshot() const {
+  const auto guard = read();
+  if (!guard) {
+    return std::nullopt;
+  }
+  return *guard;
+}
+
+std::atomic<uint64_t>& IncumbentStore::enter() const {
+  // Start at a per-thread slot so concurrent readers rarely contend for the same one
+  const size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % max_readers;
+
+  for (;;) {
+    for (size_t i = 0; i < max_readers; ++i) {
+      auto& slot = readers_[(start + i) % max_readers].epoch;
+      uint64_t expected = 0;
+
+      // The epoch is read before the slot is claimed. If an entry is retired in between, the
+      // reclaimer either sees this slot and keeps the entry, or ran before the claim, in which
+      // case the pointer loaded afterwards is already the new one.
+      if (slot.compare_exchange_strong(expected, epoch_.load())) {
+        return slot;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+void IncumbentStore::retire(Entry* entry) {
+  // Readers that announce a later epoch can no longer load this entry
+  entry->retired_at = epoch_.fetch_add(1);
+  pushRetired(entry);
+  reclaim();
+}
+
+void IncumbentStore::pushRetired(Entry* entry) noexcept {
+  entry->next_retired = retired_.load();
+  while (!retired_.compare_exchange_weak(entry->next_retired, entry)) {
+  }
+}
+
+void IncumbentStore::reclaim() {
+  // Another thread is already reclaiming; whatever it leaves gets freed by a later retire
+  std::unique_lock lock(reclaim_mutex_, std::try_to_lock);
+  if (!lock) {
+    return;
+  }
+
+  // Taking the whole stack avoids ABA problems with concurrent pushes. It must happen before the
+  // scan: a reader missed by the scan announced its epoch later, after these entries were
+  // replaced, so it cannot have loaded them.
+  Entry* entry = retired_.exchange(nullptr);
+
+  uint64_t oldest = std::numeric_limits<uint64_t>::max();
+  for (const auto& reader : readers_) {
+    if (const uint64_t epoch = reader.epoch.load(); epoch != 0) {
+      oldest = std::min(oldest, epoch);
+    }
+  }
+
+  while (entry != nullptr) {
+    Entry* next = entry->next_retired;
+    if (entry->retired_at < oldest) {
+      delete entry;
+    } else {
+      pushRetired(entry);
+    }
+    entry = next;
+  }
+}
+
+}  // namespace algorithm
+}  // namespace daa
@@ -46,6 +46,10 @@ void MultiStart::renderConfigurationUI() {
     ImGui::Text("TaskReinsertionWithinRouteSearch: Moves tasks within the same route");
     ImGui::Text("TaskReinsertionBetweenRoutesSearch: Moves tasks between different routes");
     ImGui::Text("TwoOptSearch: Reverses segments within routes");
+    ImGui::Text("OrOptSearch: Moves chains of up to 3 tasks within or between routes");
+    ImGui::Text("CrossExchangeSearch: Exchanges chains of up to 3 tasks between routes");
+    ImGui::Text("TwoOptStarSearch: Exchanges the tails of two routes");
+    ImGui::Text("SWTSReassignmentSearch: Moves trip breaks and unloading stops");
     ImGui::EndTooltip();
   }
 
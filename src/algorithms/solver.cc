@@ -41,6 +41,7 @@ void VRPTSolver::renderConfigurationUI() {
 
     // Render algorithm-specific configuration UI
     cv_algorithm_->renderConfigurationUI();
+    ImGui::Checkbox("Optimize SWTS Placement", &optimize_swts_);
 
     ImGui::Separator();
   }
@@ -0,0 +1,124 @@
+#include "algorithms/swts_placement.h"
+
+#include <vector>
+
+#include "algorithms/route_segment.h"
+
+namespace daa {
+namespace algorithm {
+
+namespace {
+
+// Earliest time found at a trip break, and how it was reached
+struct BreakLabel {
+  Duration time{};
+  std::size_t from{0};                         // First zone of the trip ending here
+  LocationIndex swts{invalid_location_index};  // SWTS unloaded at before the next trip
+  bool reached{false};
+
+  [[nodiscard]] bool isImprovedBy(Duration other) const { return !reached || other < time; }
+};
+
+}  // namespace
+
+std::optional<SWTSPlacement>
+  SWTSPlacement::optimal(std::span<const LocationIndex> zones, const VRPTProblem& problem) {
+  if (zones.empty()) {
+    return std::nullopt;
+  }
+
+  const std::size_t n = zones.size();
+  const LocationIndex depot = problem.getDepotIndex();
+  const Duration max_duration = problem.getCVMaxDuration();
+
+  // Time at the SWTS after leaving `zone` at `time`, if the vehicle can still return from it
+  const auto unloadAt = [&](LocationIndex swts, LocationIndex zone, Duration time) {
+    const Duration at_swts = time + problem.getTravelTime(zone, swts);
+    return at_swts + problem.getDepotReturn(swts).total <= max_duration
+             ? std::optional<Duration>(at_swts)
+             : std::nullopt;
+  };
+
+  // arrive[i] is the earliest arrival at zone i starting a trip, through the SWTS of the
+  // previous trip; leave[j] the earliest departure from zone j - 1 ending a trip there
+  std::vector<BreakLabel> arrive(n);
+  std::vector<BreakLabel> leave(n + 1);
+  arrive[0] = {problem.getTravelTime(depot, zones[0]), 0, invalid_location_index, true};
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i > 0 && leave[i].reached) {
+      for (const auto swts : problem.getSWTS()) {
+        if (const auto at_swts = unloadAt(swts, zones[i - 1], leave[i].time)) {
+          const Duration time = *at_swts + problem.getTravelTime(swts, zones[i]);
+          if (arrive[i].isImprovedBy(time)) {
+            arrive[i] = {time, i, swts, true};
+          }
+        }
+      }
+    }
+    if (!arrive[i].reached) {
+      continue;
+    }
+
+    // Trips starting at zone i, one zone longer each step. The load and the return checks only
+    // get stricter as zones are appended.
+    RouteSegment trip;
+    for (std::size_t j = i; j < n; ++j) {
+      trip = RouteSegment::concat(trip, RouteSegment::single(zones[j], problem), problem);
+      if (trip.headLoad() > problem.getCVCapacity() ||
+          arrive[i].time + trip.returnNeed() > max_duration) {
+        break;
+      }
+
+      const Duration time = arrive[i].time + trip.duration();
+      if (leave[j + 1].isImprovedBy(time)) {
+        leave[j + 1] = {time, i, invalid_location_index, true};
+      }
+    }
+  }
+
+  if (!leave[n].reached) {
+    return std::nullopt;
+  }
+
+  // Unload the last trip and return to the depot, which is checked like any other location
+  BreakLabel end;
+  const Duration depot_need = problem.getDepotReturn(depot).total;
+  for (const auto swts : problem.getSWTS()) {
+    if (const auto at_swts = unloadAt(swts, zones[n - 1], leave[n].time)) {
+      const Duration time = *at_swts + problem.getTravelTime(swts, depot);
+      if (time + depot_need <= max_duration && end.isImprovedBy(time)) {
+        end = {time, n, swts, true};
+      }
+    }
+  }
+  if (!end.reached) {
+    return std::nullopt;
+  }
+
+  // Recover the trips from the end of the route backwards: zones [from, to) and their SWTS
+  struct Trip {
+    std::size_t from;
+    std::size_t to;
+    LocationIndex swts;
+  };
+  std::vector<Trip> trips;
+  LocationIndex stop = end.swts;
+  for (std::size_t j = n; j > 0; j = leave[j].from) {
+    trips.push_back({leave[j].from, j, stop});
+    stop = arrive[leave[j].from].swts;
+  }
+
+  std::vector<LocationIndex> locations;
+  locations.reserve(n + trips.size() + 1);
+  for (auto it = trips.rbegin(); it != trips.rend(); ++it) {
+    locations.insert(locations.end(), zones.begin() + it->from, zones.begin() + it->to);
+    locations.push_back(it->swts);
+  }
+  locations.push_back(depot);
+
+  return SWTSPlacement(std::move(locations), end.time);
+}
+
+}  // namespace algorithm
+}  // namespace daa
@@ -1,16 +1,117 @@
 #include "commands/benchmark.h"
 
+#include <chrono>
+#include <stdexcept>
+
 #include <fmt/format.h>
 #include <CLI/CLI.hpp>
 
 #include "algorithm_factory.h"
+#include "algorithms/giant_tour.h"
+#include "algorithms/local_search/search_arena.h"
+#include "algorithms/local_search/task_reinsertion_between_routes_search.h"
+#include "algorithms/vrpt_solution.h"
 #include "commands.h"
 #include "config.h"
+#include "problem/vrpt_problem.h"
 #include "time_utils.h"
 #include "ui.h"
 
 namespace daa {
 
+namespace {
+
+/**
+ * Run a CV algorithm on each instance file, reporting the solution found in every run along
+ * with the scratch allocations its local searches made
+ *
+ * Each solution is also encoded as a giant tour and split back into routes, and the split is
+ * reported next to it. Its routes return to the depot, so zones only reachable by routes ending
+ * at an SWTS are left out; a warning names the run when that happens.
+ */
+void runBenchmarkWithFiles(
+  const std::string& algo_name,
+  int iterations,
+  const std::vector<std::string>& input_files,
+  int time_limit_ms
+) {
+  using algorithm::GiantTour;
+  using algorithm::SearchArena;
+  using algorithm::VRPTSolution;
+
+  UI::header(fmt::format("Benchmark: {}", algo_name));
+  UI::text(
+    "{:<24} {:>4} {:>10} {:>4} {:>6} {:>12} {:>12} {:>11} {:>9} {:>11} {:>11} {:>6}",
+    "instance",
+    "run",
+    "time (ms)",
+    "CVs",
+    "zones",
+    "duration (m)",
+    "arena allocs",
+    "heap blocks",
+    "split CVs",
+    "split zones",
+    "split (m)",
+    "split"
+  );
+  UI::divider();
+
+  for (const auto& file : input_files) {
+    const auto problem = VRPTProblem::loadFile(file);
+    if (!problem) {
+      throw std::runtime_error(fmt::format("Failed to load '{}'", file));
+    }
+
+    for (int run = 1; run <= iterations; ++run) {
+      auto algorithm = AlgorithmFactory::createTyped<VRPTProblem, VRPTSolution>(algo_name);
+
+      SearchArena::resetStats();
+      const auto start = std::chrono::steady_clock::now();
+      const VRPTSolution solution = algorithm->solveWithTimeLimit(*problem, time_limit_ms);
+      const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+          .count();
+      const auto arena = SearchArena::stats();
+
+      const VRPTSolution split = GiantTour::fromSolution(solution, *problem).decode(*problem);
+      const auto split_score = split.score();
+      const auto score = solution.score();
+      const char* verdict = split_score.isBetterThan(score)   ? "better"
+                            : score.isBetterThan(split_score) ? "worse"
+                                                              : "same";
+
+      UI::text(
+        "{:<24} {:>4} {:>10.1f} {:>4} {:>6} {:>12.2f} {:>12} {:>11} {:>9} {:>11} {:>11.2f} {:>6}",
+        file,
+        run,
+        elapsed_ms,
+        solution.getCVCount(),
+        solution.visitedZones(),
+        solution.totalDuration().minutes(),
+        arena.allocations,
+        arena.heap_allocations,
+        split.getCVCount(),
+        split.visitedZones(),
+        split.totalDuration().minutes(),
+        verdict
+      );
+
+      if (split.visitedZones() < solution.visitedZones()) {
+        UI::warning(fmt::format(
+          "Giant tour split of run {} on '{}' visits {} zones instead of {}",
+          run,
+          file,
+          split.visitedZones(),
+          solution.visitedZones()
+        ));
+      }
+    }
+  }
+}
+
+}  // namespace
+
 bool BenchmarkCommand::execute() {
   try {
     if (!AlgorithmFactory::exists(algo_name_)) {
@@ -41,10 +142,22 @@ bool BenchmarkCommand::execute() {
     // Set the global time limit for all algorithms
     Algorithm::DEFAULT_TIME_LIMIT_MS = time_limit_ms_;
 
+    // Every reinsertion search the algorithm creates picks up the granular options
+    using algorithm::TaskReinsertionBetweenRoutesSearch;
+    TaskReinsertionBetweenRoutesSearch::setDefaultGranularOptions(
+      {granular_, static_cast<size_t>(granular_neighbors_), granular_threshold_}
+    );
+    if (granular_) {
+      UI::info(fmt::format(
+        "Granular reinsertion: {} neighbors, threshold {}",
+        granular_neighbors_,
+        granular_threshold_
+      ));
+    }
+
     // Use either files or generated data
     if (!input_files_.empty()) {
-      throw new std::runtime_error("TODO");
-      // run_benchmark_with_files(algo_name_, iterations_, input_files_, debug_, time_limit_ms_);
+      runBenchmarkWithFiles(algo_name_, iterations_, input_files_, time_limit_ms_);
     } else {
       throw new std::runtime_error("TODO");
       // run_benchmark(algo_name_, iterations_, test_sizes_, debug_, time_limit_ms_);
@@ -71,6 +184,9 @@ void BenchmarkCommand::registerCommand(CommandRegistry& registry) {
   static bool debug = false;
   static std::string time_limit_str = "30s";
   static int time_limit_ms = Algorithm::DEFAULT_TIME_LIMIT_MS;
+  static bool granular = false;
+  static int granular_neighbors = 8;
+  static double granular_threshold = 1.5;
 
   registry.registerCommandType<BenchmarkCommand>(
     "bench",
@@ -103,6 +219,21 @@ void BenchmarkCommand::registerCommand(CommandRegistry& registry) {
         time_limit_str,
         "Time limit per algorithm run (e.g. '30s', '1m30s', '1h', or milliseconds)"
       );
+      cmd->add_flag(
+        "--granular", granular, "Only reinsert zones between routes next to their nearest zones"
+      );
+      cmd
+        ->add_option(
+          "--granular-neighbors", granular_neighbors, "Nearest zones considered in granular mode"
+        )
+        ->check(CLI::PositiveNumber);
+      cmd
+        ->add_option(
+          "--granular-threshold",
+          granular_threshold,
+          "Skip neighbors farther than this multiple of the mean neighbor distance (0 keeps all)"
+        )
+        ->check(CLI::NonNegativeNumber);
 
       // Parse the time limit string after command line parsing
       cmd->parse_complete_callback([&]() {
@@ -123,7 +254,10 @@ void BenchmarkCommand::registerCommand(CommandRegistry& registry) {
         bench_input_files,
         verbose,
         debug,
-        time_limit_ms
+        time_limit_ms,
+        granular,
+        granular_neighbors,
+        granular_threshold
       );
     }
   );
@@ -0,0 +1,208 @@
+#include "commands/kdtree_benchmark.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <CLI/CLI.hpp>
+
+#include "problem/implicit_kdtree.h"
+#include "problem/kdtree.h"
+#include "ui.h"
+
+namespace daa {
+
+namespace {
+
+// Minimal KDTreePoint so the generic tree can be benchmarked without Location objects
+struct BenchPoint {
+  double x{0.0};
+  double y{0.0};
+
+  [[nodiscard]] size_t dimensions() const noexcept { return 2; }
+  [[nodiscard]] double coordinate(size_t dim) const noexcept { return dim == 0 ? x : y; }
+};
+
+using PointerTree =
+  GenericKDTree<BenchPoint, EuclideanDistanceCalculator<BenchPoint>, std::uint32_t>;
+using ArrayTree = ImplicitKDTree<std::uint32_t>;
+
+// Side length of the square the points are drawn from, in meters
+constexpr double area_side = 100'000.0;
+
+template <typename F>
+double elapsedMs(F&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+
+double distance(const BenchPoint& a, const BenchPoint& b) {
+  return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+struct Timings {
+  double build_ms{0.0};
+  double nearest_ms{0.0};
+  double k_nearest_ms{0.0};
+  double checksum{0.0};  // Sum of result distances, compared across trees
+};
+
+}  // namespace
+
+bool KDTreeBenchmarkCommand::execute() {
+  try {
+    if (queries_ <= 0 || k_ <= 0) {
+      throw std::invalid_argument("Query count and k must be positive");
+    }
+
+    if (verbose_) {
+      UI::info(fmt::format(
+        "Configuration: sizes={}, queries={}, k={}, seed={}",
+        fmt::join(sizes_, ","),
+        queries_,
+        k_,
+        seed_
+      ));
+    }
+
+    const auto k = static_cast<size_t>(k_);
+    std::mt19937 rng(seed_);
+    std::uniform_real_distribution<double> coordinate(0.0, area_side);
+
+    UI::header("KD-tree benchmark");
+    UI::text(
+      "{:>9}  {:<8} {:>11} {:>14} {:>14}",
+      "points",
+      "tree",
+      "build (ms)",
+      "nearest (ns)",
+      fmt::format("{}-nn (ns)", k)
+    );
+    UI::divider();
+
+    for (const int size : sizes_) {
+      if (size <= 0) {
+        throw std::invalid_argument("Sizes must be positive");
+      }
+
+      std::vector<BenchPoint> points(static_cast<size_t>(size));
+      for (auto& point : points) {
+        point = {coordinate(rng), coordinate(rng)};
+      }
+
+      std::vector<BenchPoint> queries(static_cast<size_t>(queries_));
+      for (auto& query : queries) {
+        query = {coordinate(rng), coordinate(rng)};
+      }
+
+      // Pointer-based tree
+      Timings pointer;
+      {
+        std::vector<PointerTree::PointContainer> containers;
+        containers.reserve(points.size());
+        for (std::uint32_t i = 0; i < points.size(); ++i) {
+          containers.emplace_back(points[i], i);
+        }
+
+        PointerTree tree;
+        pointer.build_ms = elapsedMs([&]() { tree.build(std::move(containers)); });
+
+        pointer.nearest_ms = elapsedMs([&]() {
+          for (const auto& query : queries) {
+            pointer.checksum += distance(query, tree.findNearest(query)->point);
+          }
+        });
+
+        pointer.k_nearest_ms = elapsedMs([&]() {
+          for (const auto& query : queries) {
+            for (const auto* result : tree.findKNearest(query, k)) {
+              pointer.checksum += distance(query, result->point);
+            }
+          }
+        });
+      }
+
+      // Array-backed tree
+      Timings array;
+      {
+        std::vector<ArrayTree::Point> array_points;
+        array_points.reserve(points.size());
+        for (std::uint32_t i = 0; i < points.size(); ++i) {
+          array_points.push_back({points[i].x, points[i].y, i});
+        }
+
+        ArrayTree tree;
+        array.build_ms = elapsedMs([&]() { tree.build(std::move(array_points)); });
+
+        array.nearest_ms = elapsedMs([&]() {
+          for (const auto& query : queries) {
+            array.checksum += distance(query, points[*tree.findNearest(query.x, query.y)]);
+          }
+        });
+
+        std::vector<std::pair<double, std::uint32_t>> buffer;
+        array.k_nearest_ms = elapsedMs([&]() {
+          for (const auto& query : queries) {
+            tree.findKNearest(query.x, query.y, k, buffer);
+            for (const auto& [dist, id] : buffer) {
+              array.checksum += distance(query, points[id]);
+            }
+          }
+        });
+      }
+
+      const double per_query = 1e6 / static_cast<double>(queries_);
+      const std::array results{std::pair{"pointer", pointer}, std::pair{"array", array}};
+      for (const auto& [name, timings] : results) {
+        UI::text(
+          "{:>9}  {:<8} {:>11.2f} {:>14.1f} {:>14.1f}",
+          size,
+          name,
+          timings.build_ms,
+          timings.nearest_ms * per_query,
+          timings.k_nearest_ms * per_query
+        );
+      }
+
+      // Both trees return exact neighbors, so only ties may pick different points
+      if (std::abs(pointer.checksum - array.checksum) > 1e-6 * std::abs(pointer.checksum)) {
+        UI::warning(fmt::format("Results differ at {} points", size));
+      }
+    }
+
+    return true;
+  } catch (const std::exception& e) {
+    UI::error(fmt::format("KD-tree benchmark failed: {}", e.what()));
+    return false;
+  }
+}
+
+void KDTreeBenchmarkCommand::registerCommand(CommandRegistry& registry) {
+  static std::vector<int> sizes{1'000, 10'000, 100'000, 1'000'000};
+  static int queries = 100'000;
+  static int k = 8;
+  static std::uint32_t seed = 42;
+
+  registry.registerCommandType<KDTreeBenchmarkCommand>(
+    "bench-kdtree",
+    "Benchmark the KD-tree implementations on random points",
+    [](CLI::App* cmd) {
+      cmd->add_option("-N,--size", sizes, "Number of points (can specify multiple)")
+        ->delimiter(',');
+      cmd->add_option("-q,--queries", queries, "Queries per size");
+      cmd->add_option("-k", k, "Neighbors per k-nearest query");
+      cmd->add_option("--seed", seed, "Random seed");
+      return cmd;
+    },
+    [](bool verbose) {
+      return std::make_unique<KDTreeBenchmarkCommand>(sizes, queries, k, seed, verbose);
+    }
+  );
+}
+
+}  // namespace daa
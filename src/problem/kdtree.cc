@@ -0,0 +1,93 @@
+#include "problem/kdtree.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "problem/matrix_builder.h"
+
+namespace daa {
+
+namespace {
+
+// Rows handed to a worker at a time
+constexpr std::size_t rows_per_chunk = 256;
+
+// Below this many rows the thread start-up cost outweighs the work
+constexpr std::size_t parallel_threshold = 2048;
+
+}  // namespace
+
+NeighborLists
+  KDTree::findKNearestAll(LocationType target_type, size_t k, unsigned int threads) const {
+  const std::size_t n = locations_.size();
+  const Tree& tree = treeFor(target_type);
+
+  // Row lengths are known up front, so workers can write their rows in place
+  std::vector<std::size_t> offsets(n + 1, 0);
+  for (std::size_t row = 0; row < n; ++row) {
+    const std::size_t candidates =
+      tree.size() - (locations_[row].type() == target_type && tree.size() > 0 ? 1 : 0);
+    offsets[row + 1] = offsets[row] + std::min(k, candidates);
+  }
+
+  std::vector<LocationIndex> indices(offsets[n]);
+  std::vector<double> distances(offsets[n]);
+
+  auto fill_row = [&](std::size_t row, std::vector<Tree::Candidate>& heap) {
+    const Location& from = locations_[row];
+    const auto self = static_cast<LocationIndex>(row);
+    const std::size_t begin = offsets[row];
+
+    const auto not_self = [self](LocationIndex to) { return to != self; };
+    tree.findKNearest(from.x(), from.y(), offsets[row + 1] - begin, heap, not_self);
+
+    for (std::size_t i = 0; i < heap.size(); ++i) {
+      const Location& to = locations_[heap[i].second];
+      indices[begin + i] = to.index();
+      distances[begin + i] = MatrixBuilder::distance(from.x(), from.y(), to.x(), to.y());
+    }
+  };
+
+  unsigned int thread_count =
+    threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+  thread_count = static_cast<unsigned int>(
+    std::min<std::size_t>(thread_count, (n + rows_per_chunk - 1) / rows_per_chunk)
+  );
+
+  if (thread_count <= 1 || n < parallel_threshold) {
+    std::vector<Tree::Candidate> heap;
+    for (std::size_t row = 0; row < n; ++row) {
+      fill_row(row, heap);
+    }
+    return NeighborLists(std::move(offsets), std::move(indices), std::move(distances));
+  }
+
+  std::atomic<std::size_t> next_row{0};
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(thread_count);
+
+    for (unsigned int t = 0; t < thread_count; ++t) {
+      workers.emplace_back([&]() {
+        std::vector<Tree::Candidate> heap;
+        for (;;) {
+          const std::size_t begin = next_row.fetch_add(rows_per_chunk, std::memory_order_relaxed);
+          if (begin >= n) {
+            break;
+          }
+          const std::size_t end = std::min(n, begin + rows_per_chunk);
+          for (std::size_t row = begin; row < end; ++row) {
+            fill_row(row, heap);
+          }
+        }
+      });
+    }
+    // jthreads join when they go out of scope
+  }
+
+  return NeighborLists(std::move(offsets), std::move(indices), std::move(distances));
+}
+
+}  // namespace daa
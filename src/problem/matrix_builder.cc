@@ -0,0 +1,307 @@
+#include "problem/matrix_builder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "problem/units.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DAA_MATRIX_X86 1
+#endif
+
+// Contracting the squares into FMAs would change rounding on some paths only, so keep every
+// multiply and add separate to guarantee identical results across kernels.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace daa {
+
+namespace {
+
+// Rows handed to a worker at a time. Packed columns grow with their index, so small chunks keep
+// the threads balanced in the symmetric layout.
+constexpr std::size_t rows_per_chunk = 32;
+
+// Below this many points the thread start-up cost outweighs the work
+constexpr std::size_t parallel_threshold = 512;
+
+// Fills dist[k] with the distance from (ax, ay) to point k, and ns[k] with the travel time in
+// nanoseconds, still as a double so the conversion matches Duration's constructor.
+using RowKernel = void (*)(
+  double ax,
+  double ay,
+  const double* xs,
+  const double* ys,
+  std::size_t count,
+  double speed_kmh,
+  double* dist,
+  double* ns
+);
+
+void rowScalar(
+  double ax,
+  double ay,
+  const double* xs,
+  const double* ys,
+  std::size_t count,
+  double speed_kmh,
+  double* dist,
+  double* ns
+) {
+  for (std::size_t k = 0; k < count; ++k) {
+    const double dx = ax - xs[k];
+    const double dy = ay - ys[k];
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+    const double d = std::sqrt(dx2 + dy2);
+    dist[k] = d;
+    ns[k] = ((d * units::meters_to_kilometers) / speed_kmh * 60.0) * units::minutes_to_ns;
+  }
+}
+
+#ifdef DAA_MATRIX_X86
+
+__attribute__((target("avx2"))) void rowAVX2(
+  double ax,
+  double ay,
+  const double* xs,
+  const double* ys,
+  std::size_t count,
+  double speed_kmh,
+  double* dist,
+  double* ns
+) {
+  const __m256d vax = _mm256_set1_pd(ax);
+  const __m256d vay = _mm256_set1_pd(ay);
+  const __m256d to_km = _mm256_set1_pd(units::meters_to_kilometers);
+  const __m256d speed = _mm256_set1_pd(speed_kmh);
+  const __m256d sixty = _mm256_set1_pd(60.0);
+  const __m256d to_ns = _mm256_set1_pd(units::minutes_to_ns);
+
+  std::size_t k = 0;
+  for (; k + 4 <= count; k += 4) {
+    const __m256d dx = _mm256_sub_pd(vax, _mm256_loadu_pd(xs + k));
+    const __m256d dy = _mm256_sub_pd(vay, _mm256_loadu_pd(ys + k));
+    const __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+    _mm256_storeu_pd(dist + k, d);
+
+    const __m256d minutes = _mm256_mul_pd(_mm256_div_pd(_mm256_mul_pd(d, to_km), speed), sixty);
+    _mm256_storeu_pd(ns + k, _mm256_mul_pd(minutes, to_ns));
+  }
+
+  rowScalar(ax, ay, xs + k, ys + k, count - k, speed_kmh, dist + k, ns + k);
+}
+
+__attribute__((target("avx512f"))) void rowAVX512(
+  double ax,
+  double ay,
+  const double* xs,
+  const double* ys,
+  std::size_t count,
+  double speed_kmh,
+  double* dist,
+  double* ns
+) {
+  const __m512d vax = _mm512_set1_pd(ax);
+  const __m512d vay = _mm512_set1_pd(ay);
+  const __m512d to_km = _mm512_set1_pd(units::meters_to_kilometers);
+  const __m512d speed = _mm512_set1_pd(speed_kmh);
+  const __m512d sixty = _mm512_set1_pd(60.0);
+  const __m512d to_ns = _mm512_set1_pd(units::minutes_to_ns);
+
+  for (std::size_t k = 0; k < count; k += 8) {
+    // Masked loads and stores handle the tail without a scalar loop
+    const std::size_t remaining = count - k;
+    const __mmask8 mask =
+      remaining >= 8 ? static_cast<__mmask8>(0xFF) : static_cast<__mmask8>((1u << remaining) - 1);
+
+    const __m512d dx = _mm512_sub_pd(vax, _mm512_maskz_loadu_pd(mask, xs + k));
+    const __m512d dy = _mm512_sub_pd(vay, _mm512_maskz_loadu_pd(mask, ys + k));
+    const __m512d d = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+    _mm512_mask_storeu_pd(dist + k, mask, d);
+
+    const __m512d minutes = _mm512_mul_pd(_mm512_div_pd(_mm512_mul_pd(d, to_km), speed), sixty);
+    _mm512_mask_storeu_pd(ns + k, mask, _mm512_mul_pd(minutes, to_ns));
+  }
+}
+
+#endif  // DAA_MATRIX_X86
+
+RowKernel selectKernel(MatrixIsa isa) noexcept {
+#ifdef DAA_MATRIX_X86
+  switch (isa) {
+    case MatrixIsa::AVX512:
+      return rowAVX512;
+    case MatrixIsa::AVX2:
+      return rowAVX2;
+    case MatrixIsa::Scalar:
+      break;
+  }
+#else
+  (void)isa;
+#endif
+  return rowScalar;
+}
+
+}  // namespace
+
+MatrixIsa MatrixBuilder::detectIsa() noexcept {
+#ifdef DAA_MATRIX_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return MatrixIsa::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return MatrixIsa::AVX2;
+  }
+#endif
+  return MatrixIsa::Scalar;
+}
+
+std::string_view MatrixBuilder::isaName(MatrixIsa isa) noexcept {
+  switch (isa) {
+    case MatrixIsa::AVX512:
+      return "AVX-512";
+    case MatrixIsa::AVX2:
+      return "AVX2";
+    case MatrixIsa::Scalar:
+      break;
+  }
+  return "Scalar";
+}
+
+double MatrixBuilder::distance(double x1, double y1, double x2, double y2) noexcept {
+  double dist = 0.0;
+  double ns = 0.0;
+  rowScalar(x1, y1, &x2, &y2, 1, default_travel_speed_kmh, &dist, &ns);
+  return dist;
+}
+
+Duration MatrixBuilder::travelTime(double distance_meters, double speed_kmh) noexcept {
+  const double ns =
+    ((distance_meters * units::meters_to_kilometers) / speed_kmh * 60.0) * units::minutes_to_ns;
+  return Duration{ns, units::TimeUnit::Nanoseconds};
+}
+
+DistanceMatrix MatrixBuilder::build(
+  std::span<const double> xs,
+  std::span<const double> ys,
+  const MatrixBuildOptions& options
+) {
+  if (xs.size() != ys.size()) {
+    throw std::invalid_argument("Coordinate arrays must have the same length");
+  }
+
+  const std::size_t n = xs.size();
+  DistanceMatrix matrix(n, options.layout);
+  if (n == 0) {
+    return matrix;
+  }
+
+  // Never run a kernel the CPU lacks, even if it was explicitly requested
+  const MatrixIsa detected = detectIsa();
+  const MatrixIsa isa = std::min(options.isa.value_or(detected), detected);
+  const RowKernel kernel = selectKernel(isa);
+
+  const bool full = options.layout == DistanceMatrix::Layout::Full;
+  double* distances = matrix.distanceData();
+  Duration* travel_times = matrix.travelTimeData();
+
+  // Full rows cover every point; packed columns cover the points up to and including the anchor
+  auto fill_row = [&](std::size_t anchor, std::vector<double>& scratch) {
+    const std::size_t count = full ? n : anchor + 1;
+    const std::size_t start = matrix.offset(static_cast<LocationIndex>(anchor), 0);
+
+    scratch.resize(count);
+    kernel(
+      xs[anchor], ys[anchor], xs.data(), ys.data(), count, options.speed_kmh, distances + start,
+      scratch.data()
+    );
+
+    for (std::size_t k = 0; k < count; ++k) {
+      travel_times[start + k] = Duration{scratch[k], units::TimeUnit::Nanoseconds};
+    }
+  };
+
+  unsigned int thread_count =
+    options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  thread_count = static_cast<unsigned int>(
+    std::min<std::size_t>(thread_count, (n + rows_per_chunk - 1) / rows_per_chunk)
+  );
+
+  if (thread_count <= 1 || n < parallel_threshold) {
+    std::vector<double> scratch;
+    for (std::size_t row = 0; row < n; ++row) {
+      fill_row(row, scratch);
+    }
+    return matrix;
+  }
+
+  std::atomic<std::size_t> next_row{0};
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count);
+
+    for (unsigned int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&]() {
+        std::vector<double> scratch;
+        for (;;) {
+          const std::size_t begin = next_row.fetch_add(rows_per_chunk, std::memory_order_relaxed);
+          if (begin >= n) {
+            break;
+          }
+          const std::size_t end = std::min(n, begin + rows_per_chunk);
+          for (std::size_t row = begin; row < end; ++row) {
+            fill_row(row, scratch);
+          }
+        }
+      });
+    }
+    // jthreads join when they go out of scope
+  }
+
+  return matrix;
+}
+
+void MatrixBuilder::append(
+  DistanceMatrix& matrix,
+  std::span<const double> xs,
+  std::span<const double> ys,
+  double speed_kmh
+) {
+  if (xs.size() != ys.size()) {
+    throw std::invalid_argument("Coordinate arrays must have the same length");
+  }
+  if (xs.size() != matrix.size() + 1) {
+    throw std::invalid_argument("Coordinates must extend the matrix by exactly one point");
+  }
+
+  const auto index = static_cast<LocationIndex>(matrix.size());
+  const std::size_t count = xs.size();
+  matrix.append();
+
+  std::vector<double> distances(count);
+  std::vector<double> ns(count);
+  selectKernel(detectIsa())(
+    xs[index], ys[index], xs.data(), ys.data(), count, speed_kmh, distances.data(), ns.data()
+  );
+
+  const bool full = matrix.layout() == DistanceMatrix::Layout::Full;
+  for (LocationIndex k = 0; k < count; ++k) {
+    const Duration travel_time{ns[k], units::TimeUnit::Nanoseconds};
+    matrix.set(index, k, distances[k], travel_time);
+    if (full) {
+      matrix.set(k, index, distances[k], travel_time);
+    }
+  }
+}
+
+}  // namespace daa
@@ -192,7 +192,8 @@ Rectangle ProblemManager::GetCurrentProblemBounds() const {
   // Include SWTS locations
   try {
     const auto& swtsLocations = problem->getSWTS();
-    for (const auto& swts : swtsLocations) {
+    for (const auto swts_index : swtsLocations) {
+      const auto& swts = problem->getLocation(swts_index);
       minX = std::min(minX, static_cast<float>(swts.x()));
       minY = std::min(minY, static_cast<float>(swts.y()));
       maxX = std::max(maxX, static_cast<float>(swts.x()));
@@ -206,7 +207,8 @@ Rectangle ProblemManager::GetCurrentProblemBounds() const {
   // Include zones
   try {
     const auto& zones = problem->getZones();
-    for (const auto& zone : zones) {
+    for (const auto zone_index : zones) {
+      const auto& zone = problem->getLocation(zone_index);
       minX = std::min(minX, static_cast<float>(zone.x()));
       minY = std::min(minY, static_cast<float>(zone.y()));
       maxX = std::max(maxX, static_cast<float>(zone.x()));
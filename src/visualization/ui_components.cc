@@ -707,18 +707,16 @@ void UIComponents::RenderProblemInspector() {
             ImGui::PopFont();
             ImGui::SameLine(0, 0);
           }
-          ImGui::Text(
-            "%s: (%.2f, %.2f)", stations[i].name().c_str(), stations[i].x(), stations[i].y()
-          );
+          const auto& station = problem->getLocation(stations[i]);
+          ImGui::Text("%s: (%.2f, %.2f)", station.name().c_str(), station.x(), station.y());
         }
       }
     } else {
       if (ImGui::CollapsingHeader("Transfer Stations")) {
         const auto stations = problem->getSWTS();
         for (size_t i = 0; i < stations.size(); ++i) {
-          ImGui::Text(
-            "%s: (%.2f, %.2f)", stations[i].name().c_str(), stations[i].x(), stations[i].y()
-          );
+          const auto& station = problem->getLocation(stations[i]);
+          ImGui::Text("%s: (%.2f, %.2f)", station.name().c_str(), station.x(), station.y());
         }
       }
     }
@@ -746,7 +744,8 @@ void UIComponents::RenderProblemInspector() {
           ImGui::TableSetupColumn("Service Time");
           ImGui::TableHeadersRow();
 
-          for (const auto& zone : zones) {
+          for (const auto zone_index : zones) {
+            const auto& zone = problem->getLocation(zone_index);
             ImGui::TableNextRow();
 
             ImGui::TableSetColumnIndex(0);
@@ -781,7 +780,8 @@ void UIComponents::RenderProblemInspector() {
           ImGui::TableSetupColumn("Service Time");
           ImGui::TableHeadersRow();
 
-          for (const auto& zone : zones) {
+          for (const auto zone_index : zones) {
+            const auto& zone = problem->getLocation(zone_index);
             ImGui::TableNextRow();
 
             ImGui::TableSetColumnIndex(0);
@@ -1013,14 +1013,16 @@ void UIComponents::RenderProblemVisualization() {
   max_x = std::max(max_x, static_cast<float>(landfill.x()));
   max_y = std::max(max_y, static_cast<float>(landfill.y()));
 
-  for (const auto& station : stations) {
+  for (const auto station_index : stations) {
+    const auto& station = problem->getLocation(station_index);
     min_x = std::min(min_x, static_cast<float>(station.x()));
     min_y = std::min(min_y, static_cast<float>(station.y()));
     max_x = std::max(max_x, static_cast<float>(station.x()));
     max_y = std::max(max_y, static_cast<float>(station.y()));
   }
 
-  for (const auto& zone : zones) {
+  for (const auto zone_index : zones) {
+    const auto& zone = problem->getLocation(zone_index);
     min_x = std::min(min_x, static_cast<float>(zone.x()));
     min_y = std::min(min_y, static_cast<float>(zone.y()));
     max_x = std::max(max_x, static_cast<float>(zone.x()));
@@ -1069,7 +1071,8 @@ void UIComponents::RenderProblemVisualization() {
   };
 
   // Add transfer stations with additional data
-  for (const auto& station : stations) {
+  for (const auto station_index : stations) {
+    const auto& station = problem->getLocation(station_index);
     auto& station_obj = object_manager_->AddObject(
       {static_cast<float>(station.x()), static_cast<float>(station.y())},
       20.0f,
@@ -1088,7 +1091,8 @@ void UIComponents::RenderProblemVisualization() {
   }
 
   // Add collection zones with additional data
-  for (const auto& zone : zones) {
+  for (const auto zone_index : zones) {
+    const auto& zone = problem->getLocation(zone_index);
     float waste = static_cast<float>(zone.wasteAmount().value());
     float size = 10.0f + std::min(15.0f, waste * 0.5f);
 
@@ -1127,7 +1131,7 @@ void UIComponents::RenderProblemVisualization() {
     // Generate distinct colors for each CV route based on total count
     for (size_t i = 0; i < cv_routes.size(); ++i) {
       const auto& route = cv_routes[i];
-      const auto& locations = route.locationIds();
+      const auto& locations = route.locations();
 
       if (locations.empty())
         continue;
@@ -1159,7 +1163,7 @@ void UIComponents::RenderProblemVisualization() {
       object_manager_->AssociateNodeWithGroup(prev_id, group_id);
 
       for (size_t j = 0; j < locations.size(); ++j) {
-        const auto& loc_id = locations[j];
+        const auto& loc_id = problem->getLocation(locations[j]).id();
 
         // Skip if location not found in mapping
         if (location_coords.find(loc_id) == location_coords.end())
@@ -1196,7 +1200,7 @@ void UIComponents::RenderProblemVisualization() {
     const auto& tv_routes = solution->getTVRoutes();
     for (size_t i = 0; i < tv_routes.size(); ++i) {
       const auto& route = tv_routes[i];
-      const auto& locations = route.locationIds();
+      const auto& locations = route.locations();
 
       if (locations.empty())
         continue;
@@ -1228,7 +1232,7 @@ void UIComponents::RenderProblemVisualization() {
       object_manager_->AssociateNodeWithGroup(prev_id, group_id);
 
       for (size_t j = 0; j < locations.size(); ++j) {
-        const auto& loc_id = locations[j];
+        const auto& loc_id = problem->getLocation(locations[j]).id();
 
         // Skip if location not found in mapping
         if (location_coords.find(loc_id) == location_coords.end())
@@ -1420,9 +1424,9 @@ void UIComponents::RenderSolutionStatsWindow() {
         total_cv_time = total_cv_time + route.totalDuration();
 
         // Count only collection zones (not SWTS or other locations)
-        for (const auto& loc_id : route.locationIds()) {
+        for (const auto loc_index : route.locations()) {
           try {
-            const auto& location = problem->getLocation(loc_id);
+            const auto& location = problem->getLocation(loc_index);
             if (location.type() == LocationType::COLLECTION_ZONE) {
               zones_visited++;
             }
@@ -1499,7 +1503,7 @@ void UIComponents::RenderSolutionStatsWindow() {
           }
 
           ImGui::TableSetColumnIndex(1);
-          ImGui::Text("%zu", route.locationIds().size());
+          ImGui::Text("%zu", route.locations().size());
 
           ImGui::TableSetColumnIndex(2);
           ImGui::Text("%.1f min", route.totalDuration().value(units::TimeUnit::Minutes));
@@ -1523,7 +1527,7 @@ void UIComponents::RenderSolutionStatsWindow() {
             );
 
             // List of all locations
-            if (!route.locationIds().empty()) {
+            if (!route.locations().empty()) {
               ImGui::Separator();
               ImGui::Text("Route Path:");
               ImGui::Indent();
@@ -1532,9 +1536,9 @@ void UIComponents::RenderSolutionStatsWindow() {
               // With merge mode enabled, we can use the regular font for icons
               ImFont* regularFont = GetThemeManager().GetFont("Geist Mono");
 
-              for (size_t j = 0; j < route.locationIds().size(); j++) {
-                const auto& loc_id = route.locationIds()[j];
-                const auto& location = problem->getLocation(loc_id);
+              for (size_t j = 0; j < route.locations().size(); j++) {
+                const auto& location = problem->getLocation(route.locations()[j]);
+                const auto& loc_id = location.id();
 
                 // Add arrow icon with proper spacing
                 if (regularFont) {
@@ -1600,7 +1604,7 @@ void UIComponents::RenderSolutionStatsWindow() {
             ImGui::TableNextRow();
 
             ImGui::TableSetColumnIndex(0);
-            ImGui::Text("%s", delivery.swtsId().c_str());
+            ImGui::Text("%s", problem->getLocation(delivery.swts()).id().c_str());
 
             ImGui::TableSetColumnIndex(1);
             ImGui::Text("%.1f min", delivery.arrivalTime().value(units::TimeUnit::Minutes));
@@ -1657,7 +1661,7 @@ void UIComponents::RenderSolutionStatsWindow() {
           }
 
           ImGui::TableSetColumnIndex(1);
-          ImGui::Text("%zu", route.locationIds().size());
+          ImGui::Text("%zu", route.locations().size());
 
           ImGui::TableSetColumnIndex(2);
           ImGui::Text("%.1f min", route.currentTime().value(units::TimeUnit::Minutes));
@@ -1677,7 +1681,7 @@ void UIComponents::RenderSolutionStatsWindow() {
             ImGui::Text("Pickups: %zu", route.pickups().size());
 
             // List of all locations
-            if (!route.locationIds().empty()) {
+            if (!route.locations().empty()) {
               ImGui::Separator();
               ImGui::Text("Route Path:");
               ImGui::Indent();
@@ -1686,8 +1690,8 @@ void UIComponents::RenderSolutionStatsWindow() {
               // With merge mode enabled, we can use the regular font for icons
               ImFont* regularFont = GetThemeManager().GetFont("Geist Mono");
 
-              for (size_t j = 0; j < route.locationIds().size(); j++) {
-                const auto& loc_id = route.locationIds()[j];
+              for (size_t j = 0; j < route.locations().size(); j++) {
+                const auto& loc_id = problem->getLocation(route.locations()[j]).id();
 
                 // Add arrow icon with proper spacing
                 if (regularFont) {